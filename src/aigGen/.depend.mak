@@ -0,0 +1 @@
+aigGen.o: aigGen.cpp
@@ -0,0 +1,374 @@
+/****************************************************************************
+  FileName     [ aigGen.cpp ]
+  PackageName  [ aigGen ]
+  Synopsis     [ Generate large structured or random AIG netlists ]
+  Author       [ agent ]
+  Date         [ 2026/10/18 created ]
+****************************************************************************/
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+using namespace std;
+
+// Literal: 2 * var + inv; var 0 is const 0
+typedef uint32_t Lit;
+
+static inline Lit litNot(const Lit l) { return l ^ 1; }
+
+// Netlist in AIGER order: PIs are vars 1..nPI, ANDs follow in topological
+// order, so the binary format can be written without reordering.
+class AigNet
+{
+public:
+   AigNet(const unsigned nPI) : _nPI(nPI) {}
+
+   unsigned nPI() const { return _nPI; }
+   unsigned nAnd() const { return _vFanin0.size(); }
+   unsigned maxVar() const { return _nPI + nAnd(); }
+   Lit pi(const unsigned i) const { return 2 * (i + 1); }
+
+   Lit andLit(Lit a, Lit b) {
+      if (a < b) swap(a, b);   // AIGER: rhs0 >= rhs1
+      _vFanin0.push_back(a);
+      _vFanin1.push_back(b);
+      return 2 * maxVar();
+   }
+   Lit orLit(const Lit a, const Lit b) { return litNot(andLit(litNot(a), litNot(b))); }
+   Lit xorLit(const Lit a, const Lit b) { return orLit(andLit(a, litNot(b)), andLit(litNot(a), b)); }
+   Lit majLit(const Lit a, const Lit b, const Lit c) {
+      return orLit(andLit(a, b), andLit(c, orLit(a, b)));
+   }
+
+   void addPo(const Lit l) { _vPo.push_back(l); }
+
+   bool write(const string& fileName, const bool bBinary) const;
+
+private:
+   unsigned       _nPI;
+   vector<Lit>    _vFanin0;
+   vector<Lit>    _vFanin1;
+   vector<Lit>    _vPo;
+};
+
+// Buffered writer; fprintf is too slow for 10M+ lines
+class OutBuf
+{
+public:
+   OutBuf(FILE* f) : _f(f) { _buf.reserve(bufSize + 64); }
+   ~OutBuf() { flush(); }
+
+   void putc(const char c) { _buf += c; check(); }
+   void puts(const char* s) { _buf += s; check(); }
+   void putu(uint32_t u) {
+      char tmp[16];
+      int n = 0;
+      do { tmp[n++] = '0' + u % 10; u /= 10; } while (u);
+      while (n) _buf += tmp[--n];
+      check();
+   }
+   // AIGER binary delta encoding: 7 bits per byte, LSB first
+   void putDelta(uint32_t x) {
+      while (x & ~0x7f) { _buf += (char)((x & 0x7f) | 0x80); x >>= 7; }
+      _buf += (char)x;
+      check();
+   }
+   void flush() {
+      if (!_buf.empty()) fwrite(_buf.data(), 1, _buf.size(), _f);
+      _buf.clear();
+   }
+
+private:
+   static const size_t bufSize = 1 << 20;
+   FILE*    _f;
+   string   _buf;
+
+   void check() { if (_buf.size() >= bufSize) flush(); }
+};
+
+bool
+AigNet::write(const string& fileName, const bool bBinary) const
+{
+   FILE* f = fileName.empty() ? stdout : fopen(fileName.c_str(), "wb");
+   if (!f) return false;
+   {
+      OutBuf out(f);
+      out.puts(bBinary ? "aig " : "aag ");
+      out.putu(maxVar()); out.putc(' ');
+      out.putu(_nPI);     out.puts(" 0 ");
+      out.putu(_vPo.size()); out.putc(' ');
+      out.putu(nAnd());   out.putc('\n');
+
+      if (!bBinary)
+         for (unsigned i = 0; i < _nPI; ++i) { out.putu(pi(i)); out.putc('\n'); }
+      for (const Lit l : _vPo) { out.putu(l); out.putc('\n'); }
+      for (unsigned i = 0, n = nAnd(); i < n; ++i) {
+         const Lit lhs = 2 * (_nPI + i + 1);
+         if (bBinary) {
+            out.putDelta(lhs - _vFanin0[i]);
+            out.putDelta(_vFanin0[i] - _vFanin1[i]);
+         }
+         else {
+            out.putu(lhs);          out.putc(' ');
+            out.putu(_vFanin0[i]);  out.putc(' ');
+            out.putu(_vFanin1[i]);  out.putc('\n');
+         }
+      }
+      out.puts("c\nAIG generated by aigGen\n");
+   }
+   if (f != stdout) fclose(f);
+   return true;
+}
+
+/**************************************/
+/*   Netlist families                 */
+/**************************************/
+// n-bit ripple-carry adder: n+1 outputs
+static void
+genAdder(AigNet& net, const unsigned n)
+{
+   Lit carry = 0;
+   for (unsigned i = 0; i < n; ++i) {
+      const Lit a = net.pi(i), b = net.pi(n + i);
+      const Lit s = net.xorLit(net.xorLit(a, b), carry);
+      carry = net.majLit(a, b, carry);
+      net.addPo(s);
+   }
+   net.addPo(carry);
+}
+
+// n x n array multiplier: 2n outputs
+static void
+genMult(AigNet& net, const unsigned n)
+{
+   vector<Lit> vSum(2 * n, 0);
+   for (unsigned i = 0; i < n; ++i) {
+      Lit carry = 0;
+      for (unsigned j = 0; j < n; ++j) {
+         const Lit pp = net.andLit(net.pi(i), net.pi(n + j));
+         Lit& s = vSum[i + j];
+         const Lit t = net.xorLit(s, pp);
+         const Lit newCarry = net.majLit(s, pp, carry);
+         s = net.xorLit(t, carry);
+         carry = newCarry;
+      }
+      vSum[i + n] = carry;
+   }
+   for (const Lit l : vSum) net.addPo(l);
+}
+
+// Random DAG of nAnd ANDs, counting the planted groups and the final fold.
+// nFec groups of grpSize equivalent but structurally different nodes
+// are planted: (x&y)&z, x&(y&z), (x&z)&y, then (previous variant)&x.
+// Nodes without fanout are combined by an AND/OR tree, so every node
+// stays in the DFS list.
+//
+// Fanin phases are chosen by estimated signal probabilities, so nodes
+// stay near 0.5; otherwise deep random ANDs become almost constant 0 and
+// fall into the const group under random simulation. Random logic still
+// has a few FEC pairs besides the planted ones; after "cirsim -r",
+// "rand 16 2000 -fec 20" gives 39 FEC groups and "rand 64 100000
+// -fec 1000" gives 1013.
+static void
+genRand(AigNet& net, const unsigned nAnd, const unsigned nPo, const unsigned nFec,
+        const unsigned grpSize, mt19937_64& rng)
+{
+   vector<Lit> vNodes;     // positive literals
+   vector<char> vUsed;     // indexed by var
+   vector<double> vProb;   // indexed by var: estimated probability of 1
+   vNodes.reserve(net.nPI() + nAnd);
+   vUsed.reserve(net.nPI() + nAnd + 1);
+   vProb.reserve(net.nPI() + nAnd + 1);
+   vUsed.assign(net.nPI() + 1, 0);
+   vProb.assign(net.nPI() + 1, 0.5);
+   for (unsigned i = 0; i < net.nPI(); ++i) vNodes.push_back(net.pi(i));
+   unsigned nDangling = 0;   // ANDs in vNodes without fanout
+
+   // Prefer recent nodes, so the DAG gets deep instead of flat.
+   // Vars already in 'vPicked' are not picked again (no a&a or a&!a).
+   auto pick = [&](vector<Lit>& vPicked) -> Lit {
+      const size_t n = vNodes.size();
+      const size_t window = min(n, (size_t)4096);
+      Lit l = 0;
+      do {
+         const size_t i = (rng() & 1) ? n - 1 - rng() % window : rng() % n;
+         l = vNodes[i];
+      } while (find(vPicked.begin(), vPicked.end(), l) != vPicked.end());
+      if (!vUsed[l >> 1] && (l >> 1) > net.nPI()) --nDangling;
+      vUsed[l >> 1] = 1;
+      vPicked.push_back(l);
+      return l;
+   };
+   auto prob = [&](const Lit l) { return (l & 1) ? 1 - vProb[l >> 1] : vProb[l >> 1]; };
+   auto andNode = [&](const Lit a, const Lit b) -> Lit {
+      const Lit l = net.andLit(a, b);
+      vUsed.push_back(0);
+      vProb.push_back(prob(a) * prob(b));
+      return l;
+   };
+   // Phases of (a, b) whose AND is the closest to 0.5, ties broken randomly
+   auto andBalanced = [&](const Lit a, const Lit b) -> Lit {
+      const unsigned start = rng() & 3;
+      Lit bestA = a, bestB = b;
+      double bestDiff = 2;
+      for (unsigned k = 0; k < 4; ++k) {
+         const unsigned ph = (start + k) & 3;
+         const Lit pa = a ^ (ph & 1), pb = b ^ (ph >> 1);
+         const double diff = fabs(prob(pa) * prob(pb) - 0.5);
+         if (diff < bestDiff) { bestDiff = diff; bestA = pa; bestB = pb; }
+      }
+      return andNode(bestA, bestB);
+   };
+   auto add = [&](const Lit l) {
+      vNodes.push_back(l & ~1u);
+      ++nDangling;
+   };
+
+   // Cost of the fold below: one AND per dangling node not driving a PO
+   auto foldCost = [&]() -> unsigned { return nDangling > nPo ? nDangling - nPo : 0; };
+   // Planted group: 6 ANDs for the 3 variants, one more per extra member
+   const unsigned grpCost = 6 + (grpSize > 3 ? grpSize - 3 : 0);
+   vector<Lit> vPicked;
+   auto plant = [&]() {
+      vPicked.clear();
+      const Lit x = pick(vPicked) ^ (rng() & 1), y = pick(vPicked) ^ (rng() & 1),
+                z = pick(vPicked) ^ (rng() & 1);
+      Lit v[3] = { andNode(andNode(x, y), z),
+                   andNode(x, andNode(y, z)),
+                   andNode(andNode(x, z), y) };
+      for (unsigned j = 0; j < grpSize; ++j) {
+         if (j >= 3) v[j % 3] = andNode(v[j % 3], x);
+         add(v[j % 3]);
+      }
+   };
+
+   // Plain ANDs until the budget left is what the unplanted groups need;
+   // groups are planted evenly over the budget
+   unsigned nPlanted = 0;
+   while (true) {
+      const uint64_t total = net.nAnd() + foldCost();
+      if (total + (uint64_t)(nFec - nPlanted) * (grpCost + grpSize) >= nAnd) break;
+      if (nPlanted < nFec && vNodes.size() >= 3 && total * nFec >= (uint64_t)nPlanted * nAnd) {
+         plant();
+         ++nPlanted;
+         continue;
+      }
+      vPicked.clear();
+      const Lit a = pick(vPicked), b = pick(vPicked);
+      add(andBalanced(a, b));
+   }
+   if (nPlanted < nFec && vNodes.size() < 3) {
+      vPicked.clear();
+      const Lit a = pick(vPicked), b = pick(vPicked);
+      add(andBalanced(a, b));
+   }
+   for (; nPlanted < nFec; ++nPlanted) plant();
+
+   // POs: the latest nodes, then fold dangling nodes into the last PO
+   vector<Lit> vDangling;
+   for (size_t i = net.nPI(); i < vNodes.size(); ++i)
+      if (!vUsed[vNodes[i] >> 1]) vDangling.push_back(vNodes[i]);
+   const unsigned nDirect = min((size_t)nPo, vDangling.size());
+   for (unsigned i = 0; i + 1 < nDirect; ++i) {
+      net.addPo(vDangling.back());
+      vDangling.pop_back();
+   }
+   // Fold nodes from all over the DAG together, not just neighbours
+   shuffle(vDangling.begin(), vDangling.end(), rng);
+   bool bOr = false;
+   while (vDangling.size() > 1) {
+      vector<Lit> vNext;
+      for (size_t i = 0; i + 1 < vDangling.size(); i += 2)
+         vNext.push_back(bOr ? net.orLit(vDangling[i], vDangling[i + 1])
+                             : net.andLit(vDangling[i], vDangling[i + 1]));
+      if (vDangling.size() & 1) vNext.push_back(vDangling.back());
+      vDangling.swap(vNext);
+      bOr = !bOr;
+   }
+   if (!vDangling.empty()) net.addPo(vDangling[0]);
+}
+
+/**************************************/
+/*   main                             */
+/**************************************/
+static void
+usage()
+{
+   cerr << "Usage: aigGen <family> [options]\n"
+        << "   family:\n"
+        << "      adder <#bits>\n"
+        << "      mult  <#bits>\n"
+        << "      rand  <#PI> <#AND> [-po <#PO>] [-fec <#group>] [-grpsize <size>]\n"
+        << "   options:\n"
+        << "      -o <file>      output file (default: stdout)\n"
+        << "      -binary        binary AIGER (.aig) instead of ASCII (.aag)\n"
+        << "      -seed <int>    random seed of 'rand' (default: 0)\n"
+        << "   e.g. aigGen rand 64 10000000 -fec 1000 -o r10m.aag" << endl;
+   exit(1);
+}
+
+static unsigned
+toUnsigned(const char* s)
+{
+   char* end = nullptr;
+   const double d = strtod(s, &end);   // accept 1e7
+   if (!end || *end || d < 0 || d > 4e9) usage();
+   return (unsigned)d;
+}
+
+int
+main(int argc, char** argv)
+{
+   if (argc < 3) usage();
+   const string family = argv[1];
+   vector<unsigned> vArgs;
+   string fileName;
+   bool bBinary = false;
+   unsigned seed = 0, nPo = 1, nFec = 0, grpSize = 2;
+
+   for (int i = 2; i < argc; ++i) {
+      const string opt = argv[i];
+      if (opt == "-o" && i + 1 < argc) fileName = argv[++i];
+      else if (opt == "-binary") bBinary = true;
+      else if (opt == "-seed" && i + 1 < argc) seed = toUnsigned(argv[++i]);
+      else if (opt == "-po" && i + 1 < argc) nPo = toUnsigned(argv[++i]);
+      else if (opt == "-fec" && i + 1 < argc) nFec = toUnsigned(argv[++i]);
+      else if (opt == "-grpsize" && i + 1 < argc) grpSize = toUnsigned(argv[++i]);
+      else if (opt[0] != '-') vArgs.push_back(toUnsigned(argv[i]));
+      else usage();
+   }
+
+   AigNet* net = nullptr;
+   if (family == "adder" && vArgs.size() == 1 && vArgs[0] > 0) {
+      net = new AigNet(2 * vArgs[0]);
+      genAdder(*net, vArgs[0]);
+   }
+   else if (family == "mult" && vArgs.size() == 1 && vArgs[0] > 0) {
+      net = new AigNet(2 * vArgs[0]);
+      genMult(*net, vArgs[0]);
+   }
+   else if (family == "rand" && vArgs.size() == 2 && vArgs[0] >= 2 && grpSize >= 2) {
+      mt19937_64 rng(seed);
+      net = new AigNet(vArgs[0]);
+      genRand(*net, vArgs[1], max(1u, nPo), nFec, grpSize, rng);
+   }
+   else usage();
+
+   if (!net->write(fileName, bBinary)) {
+      cerr << "Error: cannot open file \"" << fileName << "\"!!" << endl;
+      return 1;
+   }
+   if (!fileName.empty())
+      cerr << "AIG generated: " << net->nPI() << " PI(s), " << net->nAnd()
+           << " AND(s). (" << fileName << ")" << endl;
+   delete net;
+   return 0;
+}
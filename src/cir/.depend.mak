@@ -1,44 +1,76 @@
-cirGate.o: cirGate.cpp cirGate.h cirDef.h ../../include/myHashMap.h \
- ../../include/sat.h ../../include/Solver.h ../../include/SolverTypes.h \
- ../../include/Global.h ../../include/VarOrder.h ../../include/Heap.h \
- ../../include/Proof.h ../../include/File.h cirMgr.h cirModel.h \
- cirFecGrp.h cirSimValue.h ../../include/util.h ../../include/rnGen.h \
- ../../include/myUsage.h
-cirSim.o: cirSim.cpp cirMgr.h cirDef.h ../../include/myHashMap.h \
+cirApi.o: cirApi.cpp cirApi.h cirMgr.h cirDef.h ../../include/myHashMap.h \
  cirGate.h ../../include/sat.h ../../include/Solver.h \
  ../../include/SolverTypes.h ../../include/Global.h \
  ../../include/VarOrder.h ../../include/Heap.h ../../include/Proof.h \
- ../../include/File.h cirModel.h cirFecGrp.h cirSimValue.h \
- ../../include/util.h ../../include/rnGen.h ../../include/myUsage.h
-cirMgr.o: cirMgr.cpp cirMgr.h cirDef.h ../../include/myHashMap.h \
+ ../../include/File.h cirModel.h cirPattern.h cirSimLog.h cirMsg.h \
+ cirStat.h cirFecGrp.h cirSimStop.h cirStrash.h cirVisit.h cirSnapshot.h
+cirCmd.o: cirCmd.cpp cirMgr.h cirDef.h ../../include/myHashMap.h \
  cirGate.h ../../include/sat.h ../../include/Solver.h \
  ../../include/SolverTypes.h ../../include/Global.h \
  ../../include/VarOrder.h ../../include/Heap.h ../../include/Proof.h \
- ../../include/File.h cirModel.h cirFecGrp.h cirSimValue.h \
- ../../include/util.h ../../include/rnGen.h ../../include/myUsage.h
+ ../../include/File.h cirModel.h cirPattern.h cirSimLog.h cirMsg.h \
+ cirStat.h cirFecGrp.h cirSimStop.h cirStrash.h cirVisit.h cirSnapshot.h \
+ cirCmd.h ../../include/cmdParser.h ../../include/cmdCharDef.h \
+ ../../include/util.h ../../include/rnGen.h ../../include/myUsage.h \
+ ../../include/myTrace.h
 cirFraig.o: cirFraig.cpp cirMgr.h cirDef.h ../../include/myHashMap.h \
  cirGate.h ../../include/sat.h ../../include/Solver.h \
  ../../include/SolverTypes.h ../../include/Global.h \
  ../../include/VarOrder.h ../../include/Heap.h ../../include/Proof.h \
- ../../include/File.h cirModel.h cirFecGrp.h cirSimValue.h \
+ ../../include/File.h cirModel.h cirPattern.h cirSimLog.h cirMsg.h \
+ cirStat.h cirFecGrp.h cirSimStop.h cirStrash.h cirVisit.h cirSnapshot.h \
  ../../include/myHashSet.h ../../include/util.h ../../include/rnGen.h \
- ../../include/myUsage.h cirStrash.h
-cirCmd.o: cirCmd.cpp cirMgr.h cirDef.h ../../include/myHashMap.h \
+ ../../include/myUsage.h ../../include/myTrace.h
+cirGate.o: cirGate.cpp cirGate.h cirDef.h ../../include/myHashMap.h \
+ ../../include/sat.h ../../include/Solver.h ../../include/SolverTypes.h \
+ ../../include/Global.h ../../include/VarOrder.h ../../include/Heap.h \
+ ../../include/Proof.h ../../include/File.h cirMgr.h cirModel.h \
+ cirPattern.h cirSimLog.h cirMsg.h cirStat.h cirFecGrp.h cirSimStop.h \
+ cirStrash.h cirVisit.h cirSnapshot.h ../../include/util.h \
+ ../../include/rnGen.h ../../include/myUsage.h ../../include/myTrace.h
+cirMgr.o: cirMgr.cpp cirMgr.h cirDef.h ../../include/myHashMap.h \
  cirGate.h ../../include/sat.h ../../include/Solver.h \
  ../../include/SolverTypes.h ../../include/Global.h \
  ../../include/VarOrder.h ../../include/Heap.h ../../include/Proof.h \
- ../../include/File.h cirModel.h cirFecGrp.h cirSimValue.h cirCmd.h \
- ../../include/cmdParser.h ../../include/cmdCharDef.h \
- ../../include/util.h ../../include/rnGen.h ../../include/myUsage.h
+ ../../include/File.h cirModel.h cirPattern.h cirSimLog.h cirMsg.h \
+ cirStat.h cirFecGrp.h cirSimStop.h cirStrash.h cirVisit.h cirSnapshot.h \
+ ../../include/util.h ../../include/rnGen.h ../../include/myUsage.h \
+ ../../include/myTrace.h
+cirMsg.o: cirMsg.cpp cirMsg.h
 cirOpt.o: cirOpt.cpp cirMgr.h cirDef.h ../../include/myHashMap.h \
  cirGate.h ../../include/sat.h ../../include/Solver.h \
  ../../include/SolverTypes.h ../../include/Global.h \
  ../../include/VarOrder.h ../../include/Heap.h ../../include/Proof.h \
- ../../include/File.h cirModel.h cirFecGrp.h cirSimValue.h \
- ../../include/util.h ../../include/rnGen.h ../../include/myUsage.h
+ ../../include/File.h cirModel.h cirPattern.h cirSimLog.h cirMsg.h \
+ cirStat.h cirFecGrp.h cirSimStop.h cirStrash.h cirVisit.h cirSnapshot.h \
+ ../../include/util.h ../../include/rnGen.h ../../include/myUsage.h \
+ ../../include/myTrace.h
 cirParse.o: cirParse.cpp cirMgr.h cirDef.h ../../include/myHashMap.h \
  cirGate.h ../../include/sat.h ../../include/Solver.h \
  ../../include/SolverTypes.h ../../include/Global.h \
  ../../include/VarOrder.h ../../include/Heap.h ../../include/Proof.h \
- ../../include/File.h cirModel.h cirFecGrp.h cirSimValue.h \
- ../../include/util.h ../../include/rnGen.h ../../include/myUsage.h
+ ../../include/File.h cirModel.h cirPattern.h cirSimLog.h cirMsg.h \
+ cirStat.h cirFecGrp.h cirSimStop.h cirStrash.h cirVisit.h cirSnapshot.h \
+ ../../include/util.h ../../include/rnGen.h ../../include/myUsage.h \
+ ../../include/myTrace.h
+cirPattern.o: cirPattern.cpp cirPattern.h cirDef.h \
+ ../../include/myHashMap.h cirModel.h
+cirSim.o: cirSim.cpp cirMgr.h cirDef.h ../../include/myHashMap.h \
+ cirGate.h ../../include/sat.h ../../include/Solver.h \
+ ../../include/SolverTypes.h ../../include/Global.h \
+ ../../include/VarOrder.h ../../include/Heap.h ../../include/Proof.h \
+ ../../include/File.h cirModel.h cirPattern.h cirSimLog.h cirMsg.h \
+ cirStat.h cirFecGrp.h cirSimStop.h cirStrash.h cirVisit.h cirSnapshot.h \
+ ../../include/util.h ../../include/rnGen.h ../../include/myUsage.h \
+ ../../include/myTrace.h
+cirSimLog.o: cirSimLog.cpp cirSimLog.h cirDef.h ../../include/myHashMap.h \
+ cirModel.h
+cirSnapshot.o: cirSnapshot.cpp cirMgr.h cirDef.h \
+ ../../include/myHashMap.h cirGate.h ../../include/sat.h \
+ ../../include/Solver.h ../../include/SolverTypes.h \
+ ../../include/Global.h ../../include/VarOrder.h ../../include/Heap.h \
+ ../../include/Proof.h ../../include/File.h cirModel.h cirPattern.h \
+ cirSimLog.h cirMsg.h cirStat.h cirFecGrp.h cirSimStop.h cirStrash.h \
+ cirVisit.h cirSnapshot.h ../../include/util.h ../../include/rnGen.h \
+ ../../include/myUsage.h ../../include/myTrace.h
+cirStat.o: cirStat.cpp cirStat.h
@@ -0,0 +1,102 @@
+/****************************************************************************
+  FileName     [ cirApi.cpp ]
+  PackageName  [ cir ]
+  Synopsis     [ Define the library interface of the cir package ]
+  Author       [ agent ]
+  Date         [ 2026/10/18 created ]
+****************************************************************************/
+
+#include <fstream>
+#include "cirApi.h"
+
+using namespace std;
+
+/*******************************/
+/*   Library functions         */
+/*******************************/
+CirReadResult
+cirRead(CirMgr& mgr, const string& fileName, const bool doStrash)
+{
+   CirReadResult res;
+   res.bOk = mgr.readCircuit(fileName, doStrash);
+   if (res.bOk) res.size = CirSize(mgr);
+   else res.errMsg = mgr.errMsg();
+   return res;
+}
+
+CirSimResult
+cirRandomSim(CirMgr& mgr, const size_t seed, CirSimStop* stop)
+{
+   CirSimResult res;
+   res.nPatterns = mgr.randomSim(seed, stop);
+   res.nFecGrps = mgr.fecGrps().nGrps();
+   res.nCands = mgr.fecGrps().nCands();
+   return res;
+}
+
+CirStrashResult
+cirStrash(CirMgr& mgr, const unsigned nThreads)
+{
+   CirStrashResult res;
+   res.before = CirSize(mgr);
+   mgr.strash(nThreads);
+   res.after = CirSize(mgr);
+   return res;
+}
+
+CirFraigResult
+cirFraig(CirMgr& mgr, const double seconds, const long long conflicts)
+{
+   CirFraigResult res;
+   CirStat& stat = mgr.stat();
+   const bool bOldEnabled = stat.enabled();
+   stat.reset();
+   stat.setEnabled(true);
+
+   res.before = CirSize(mgr);
+   mgr.setFraigLimit(seconds, conflicts);
+   res.bTimeout = !mgr.fraig();
+   mgr.setFraigLimit(0, 0);
+   res.after = CirSize(mgr);
+   for (unsigned i = 0; i < CirStat::SAT_TOT; ++i)
+      res.nSatCalls[i] = stat.nSatCalls(CirStat::SatResult(i));
+   res.nMerged = stat.nMerges();
+
+   stat.setEnabled(bOldEnabled);
+   return res;
+}
+
+CirWriteResult
+cirWrite(const CirMgr& mgr, const string& fileName)
+{
+   CirWriteResult res;
+   ofstream fout(fileName.c_str());
+   if (!fout) {
+      res.errMsg = "Cannot open file \"" + fileName + "\"!!\n";
+      return res;
+   }
+   mgr.writeAag(fout);
+   res.bOk = (bool)fout;
+   if (!res.bOk) res.errMsg = "Cannot write file \"" + fileName + "\"!!\n";
+   return res;
+}
+
+CirWriteResult
+cirSave(const CirMgr& mgr, const string& fileName)
+{
+   CirWriteResult res;
+   res.bOk = mgr.saveSnapshot(fileName);
+   if (!res.bOk) res.errMsg = "Cannot write file \"" + fileName + "\"!!\n";
+   return res;
+}
+
+CirReadResult
+cirLoad(CirMgr& mgr, const string& fileName)
+{
+   CirReadResult res;
+   unsigned flowState = 0;
+   res.bOk = mgr.loadSnapshot(fileName, flowState);
+   if (res.bOk) res.size = CirSize(mgr);
+   else res.errMsg = mgr.errMsg();
+   return res;
+}
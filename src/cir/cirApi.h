@@ -0,0 +1,101 @@
+/****************************************************************************
+  FileName     [ cirApi.h ]
+  PackageName  [ cir ]
+  Synopsis     [ Library interface of the cir package ]
+  Author       [ agent ]
+  Date         [ 2026/10/18 created ]
+****************************************************************************/
+
+#ifndef CIRAPI_H
+#define CIRAPI_H
+
+#include <string>
+#include "cirMgr.h"
+
+using namespace std;
+
+// Every function works on the given CirMgr only, so different circuits can
+// be processed by different threads at the same time (one CirMgr per thread
+// at a time). Messages follow the CirMgr's verbosity; set CIR_VERB_QUIET to
+// keep the library silent. myTrace is not thread-safe; keep it closed when
+// several threads are running.
+//
+// e.g.
+//    CirMgr mgr;
+//    mgr.setVerbosity(CIR_VERB_QUIET);
+//    if (!cirRead(mgr, "c17.aag").bOk) ...
+//    cirStrash(mgr);
+//    cirRandomSim(mgr, 1);
+//    CirFraigResult r = cirFraig(mgr);
+
+struct CirSize
+{
+   CirSize() : nPi(0), nPo(0), nAig(0) {}
+   CirSize(const CirMgr& mgr) : nPi(mgr.nPi()), nPo(mgr.nPo()), nAig(mgr.nAig()) {}
+
+   unsigned nPi;
+   unsigned nPo;
+   unsigned nAig;
+};
+
+struct CirReadResult
+{
+   CirReadResult() : bOk(false) {}
+
+   bool     bOk;
+   string   errMsg;
+   CirSize  size;
+};
+
+struct CirSimResult
+{
+   CirSimResult() : nPatterns(0), nFecGrps(0), nCands(0) {}
+
+   unsigned nPatterns;   // patterns simulated by this call
+   unsigned nFecGrps;    // FEC groups after simulation
+   unsigned nCands;      // gates in FEC groups
+};
+
+struct CirStrashResult
+{
+   CirSize  before;
+   CirSize  after;
+};
+
+struct CirFraigResult
+{
+   CirFraigResult() : nMerged(0), bTimeout(false) {
+      for (unsigned i = 0; i < CirStat::SAT_TOT; ++i) nSatCalls[i] = 0;
+   }
+
+   CirSize  before;
+   CirSize  after;
+   unsigned nSatCalls[CirStat::SAT_TOT];   // by CirStat::SatResult
+   unsigned nMerged;
+   bool     bTimeout;   // stopped by the time limit
+};
+
+struct CirWriteResult
+{
+   CirWriteResult() : bOk(false) {}
+
+   bool     bOk;
+   string   errMsg;
+};
+
+// 'mgr' must be newly constructed
+CirReadResult   cirRead(CirMgr& mgr, const string& fileName, const bool doStrash = false);
+// Random simulation until 'stop' (default: CirSimStopGrp) says so
+CirSimResult    cirRandomSim(CirMgr& mgr, const size_t seed = 0, CirSimStop* stop = nullptr);
+// nThreads > 0: level-parallel strash, see CirMgr::strash()
+CirStrashResult cirStrash(CirMgr& mgr, const unsigned nThreads = 0);
+// Like CIRFraig, FEC groups must be found by simulation first.
+// Limits (0: none): stop after 'seconds', give up a pair after 'conflicts'
+CirFraigResult  cirFraig(CirMgr& mgr, const double seconds = 0, const long long conflicts = 0);
+CirWriteResult  cirWrite(const CirMgr& mgr, const string& fileName);
+// Binary snapshot of the full state, e.g. to fraig later without simulating
+// again; 'mgr' of cirLoad() must be newly constructed
+CirWriteResult  cirSave(const CirMgr& mgr, const string& fileName);
+CirReadResult   cirLoad(CirMgr& mgr, const string& fileName);
+
+#endif // CIRAPI_H
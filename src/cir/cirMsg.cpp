@@ -0,0 +1,100 @@
+/****************************************************************************
+  FileName     [ cirMsg.cpp ]
+  PackageName  [ cir ]
+  Synopsis     [ Define verbosity control of cir progress messages ]
+  Author       [ agent ]
+  Date         [ 2026/10/18 created ]
+****************************************************************************/
+
+#include <cstdio>
+#include <cstdarg>
+#include <algorithm>
+#include "cirMsg.h"
+
+using namespace std;
+
+/******************************/
+/*   class CirMsg functions   */
+/******************************/
+void
+CirMsg::begin()
+{
+   _nItems = 0;
+   _bTicked = false;
+   _start = _lastTick = chrono::steady_clock::now();
+}
+
+void
+CirMsg::gate(const char* fmt, ...)
+{
+   va_list ap;
+   va_start(ap, fmt);
+   if (_verb == CIR_VERB_FULL)
+      vfprintf(stdout, fmt, ap);
+   else if (_buf.size() < maxBufSize) {
+      char line[256];
+      const int n = vsnprintf(line, sizeof(line), fmt, ap);
+      if (n > 0) _buf.append(line, min((size_t)n, sizeof(line) - 1));
+   }
+   else ++_nDropped;
+   va_end(ap);
+}
+
+void
+CirMsg::tick(const char* fmt, ...)
+{
+   if (_verb != CIR_VERB_SUMMARY) return;
+   const auto now = chrono::steady_clock::now();
+   if (now - _lastTick < chrono::milliseconds(500)) return;
+   _lastTick = now;
+   _bTicked = true;
+
+   va_list ap;
+   va_start(ap, fmt);
+   fprintf(stdout, "\r");
+   vfprintf(stdout, fmt, ap);
+   fflush(stdout);
+   va_end(ap);
+}
+
+// e.g. "Strashing: 1234 merged (0.52 s, 2373 merged/s)"
+void
+CirMsg::end(const char* phase, const char* itemStr)
+{
+   if (_verb != CIR_VERB_SUMMARY) return;
+   const double sec = chrono::duration<double>(chrono::steady_clock::now() - _start).count();
+   clearTick();
+   fprintf(stdout, "%s: %u %s (%.2f s", phase, _nItems, itemStr, sec);
+   if (sec > 0.0) fprintf(stdout, ", %.0f %s/s", _nItems / sec, itemStr);
+   fprintf(stdout, ")\n");
+}
+
+void
+CirMsg::clearTick()
+{
+   if (!_bTicked) return;
+   fprintf(stdout, "\r%*s\r", 79, "");
+   _bTicked = false;
+}
+
+// Summary line printed in SUMMARY and FULL modes
+void
+CirMsg::summary(const char* fmt, ...)
+{
+   if (_verb == CIR_VERB_QUIET) return;
+   va_list ap;
+   va_start(ap, fmt);
+   vfprintf(stdout, fmt, ap);
+   va_end(ap);
+}
+
+void
+CirMsg::dump(ostream& os)
+{
+   os << _buf;
+   if (_nDropped)
+      os << "... " << _nDropped << " more message(s) dropped" << endl;
+   os.flush();
+   _buf.clear();
+   _nDropped = 0;
+}
@@ -0,0 +1,65 @@
+/****************************************************************************
+  FileName     [ cirMsg.h ]
+  PackageName  [ cir ]
+  Synopsis     [ Verbosity control of cir progress messages ]
+  Author       [ agent ]
+  Date         [ 2026/10/18 created ]
+****************************************************************************/
+
+#ifndef CIRMSG_H
+#define CIRMSG_H
+
+#include <string>
+#include <chrono>
+#include <ostream>
+
+using namespace std;
+
+enum CirVerbosity
+{
+   CIR_VERB_QUIET,     // no progress message
+   CIR_VERB_SUMMARY,   // one summary line per phase, rate-limited ticker
+   CIR_VERB_FULL       // one message per gate (default)
+};
+
+// Progress messages of a phase (e.g. strash, fraig):
+//    - gate(): per-gate message; printed in FULL mode, buffered otherwise
+//    - tick(): progress ticker; printed in SUMMARY mode at most every 0.5 s
+//    - end() : summary line with #items and the rate; SUMMARY mode only
+//    - summary(): phase result (e.g. logic depth); not printed in QUIET mode
+class CirMsg
+{
+public:
+   CirMsg() : _verb(CIR_VERB_FULL), _nDropped(0), _nItems(0), _bTicked(false) {}
+   ~CirMsg() {}
+
+   void         setVerbosity(const CirVerbosity v) { _verb = v; }
+   CirVerbosity verbosity() const { return _verb; }
+   bool         isFull() const { return _verb == CIR_VERB_FULL; }
+
+   void begin();
+   void addItems(const unsigned n = 1) { _nItems += n; }
+   void gate(const char* fmt, ...) __attribute__((format(printf, 2, 3)));
+   void tick(const char* fmt, ...) __attribute__((format(printf, 2, 3)));
+   void end(const char* phase, const char* itemStr);
+   void clearTick();
+   void summary(const char* fmt, ...) __attribute__((format(printf, 2, 3)));
+
+   // Emit and clear the buffered per-gate messages
+   void dump(ostream& os);
+
+private:
+   static const size_t maxBufSize = 1 << 24;
+
+   CirVerbosity   _verb;
+   string         _buf;        // buffered per-gate messages
+   size_t         _nDropped;   // messages not buffered (buffer is full)
+
+   // Current phase
+   unsigned       _nItems;
+   bool           _bTicked;
+   chrono::steady_clock::time_point _start;
+   chrono::steady_clock::time_point _lastTick;
+};
+
+#endif // CIRMSG_H
@@ -7,6 +7,9 @@
 ****************************************************************************/
 
 #include <cassert>
+#include <queue>
+#include <vector>
+#include <algorithm>
 #include "cirMgr.h"
 #include "cirGate.h"
 #include "util.h"
@@ -19,8 +22,6 @@ using namespace std;
 /*******************************/
 /*   Global variable and enum  */
 /*******************************/
-extern unsigned globalRef;
-
 
 /**************************************/
 /*   Static varaibles and functions   */
@@ -35,42 +36,54 @@ extern unsigned globalRef;
 void
 CirMgr::sweep()
 {
+   MyTraceScope trace("sweep", "opt");
    // Mark all gates in DFS List
-   ++globalRef;
+   CirVisit visit(_vAllGates.size());
    for (unsigned i = 0, n = _vDfsList.size(); i < n; ++i) {
-      _vDfsList[i]->setRef(globalRef);
+      visit.visit(_vDfsList[i]);
       // [Note] UNDEF gates never exist in DFS list.
       //        So, make sure that UNDEF gates which 
       //        can be reached by POs will be marked.
       if (_vDfsList[i]->isPo()) {
-         _vDfsList[i]->fanin0_gate()->setRef(globalRef);
+         visit.visit(_vDfsList[i]->fanin0_gate());
       } else if (_vDfsList[i]->isFloating()) { 
-         _vDfsList[i]->fanin0_gate()->setRef(globalRef);
-         _vDfsList[i]->fanin1_gate()->setRef(globalRef);
+         visit.visit(_vDfsList[i]->fanin0_gate());
+         visit.visit(_vDfsList[i]->fanin1_gate());
       } else {}
    }
 
-   // Sweeping unmarked gates
+   // Detach unmarked AIGs from their fanins first,
+   // since a fanin may be swept before its fanout
    CirGate* g = nullptr; // for convenient
+   for (unsigned i = 0, n = _vAllGates.size(); i < n; ++i) {
+      if ((g = _vAllGates[i]) && !visit.isVisited(g) && g->isAig()) {
+         g->fanin0_gate()->rmFanout(g);
+         g->fanin1_gate()->rmFanout(g);
+      }
+   }
+
+   // Sweeping unmarked gates
+   _msg.begin();
    for (unsigned i = 0, n = _vAllGates.size(); i < n; ++i) {
       if (_vAllGates[i] && (g = _vAllGates[i])) {
-         if (g->ref() != globalRef) {
+         if (!visit.isVisited(g)) {
             // sweep AIG
             if (g->isAig()) {
-               g->fanin0_gate()->rmFanout(g);
-               g->fanin1_gate()->rmFanout(g);
-               fprintf(stdout, "Sweeping: AIG(%d) removed...\n", g->var());
+               _msg.gate("Sweeping: AIG(%d) removed...\n", g->var());
+               _msg.addItems();
                delGate(g);
             }
             // sweep UNDEF
             else if (g->isUndef()) {
-               fprintf(stdout, "Sweeping: UNDEF(%d) removed...\n", g->var());
+               _msg.gate("Sweeping: UNDEF(%d) removed...\n", g->var());
+               _msg.addItems();
                delGate(g);
             }
             else {}
          }
       }
    }
+   _msg.end("Sweeping", "removed");
 
    // Update Lists
    buildFloatingList();
@@ -81,59 +94,129 @@ CirMgr::sweep()
    sortAllGateFanout();
 }
 
-// Recursively simplifying from POs;
+// Simplify AIG gates by a worklist until a fixpoint is reached;
+// fanouts of a simplified gate are pushed back to the worklist.
 // _dfsList needs to be reconstructed afterwards
 // UNDEF gates may be delete if its fanout becomes empty...
 void
 CirMgr::optimize()
 {
-   CirGate* g = nullptr;
+   MyTraceScope trace("optimize", "opt");
+   // Only gates in DFS list are optimized (unused gates are left to sweep)
+   CirVisit visit(_vAllGates.size());
+   for (unsigned i = 0, n = _vDfsList.size(); i < n; ++i)
+      visit.visit(_vDfsList[i]);
+
+   // Worklist stores var, since a queued gate may be merged (deleted)
+   queue<unsigned> qWork;
+   vector<bool> vQueued(_vAllGates.size(), false);
    for (unsigned i = 0, n = _vDfsList.size(); i < n; ++i) {
-      // Skip non-AIG gate
       if (!_vDfsList[i]->isAig()) continue;
+      qWork.push(_vDfsList[i]->var());
+      vQueued[_vDfsList[i]->var()] = true;
+   }
 
-      g = _vDfsList[i];
-      // Apply trivial optimization (4 cases)
-      //    Case1: One of fanins is const0
-      //    Case2: One of fanins is const1
-      //    Case3: Two fanins are the same (var) and in the same phase
-      //    Case4: Two fanins are the same (var) but in inverting phase
-      // 
-      if ( g->fanin0_gate() == constGate() ) {
-         if ( !g->fanin0_inv() ) { 
-            // case1
-            mergeGate(constGate(), g, false);
-            fprintf(stdout, "Simplifying: %u merging %u...\n", constGate()->var(), g->var());
-         } else{
-            // case2
-            mergeGate(g->fanin1_gate(), g, g->fanin1_inv());
-            fprintf(stdout, "Simplifying: %u merging %s%u...\n", 
-               g->fanin1_gate()->var(), (g->fanin1_inv() ? "!" : ""), g->var());
-         }
-      } else if ( g->fanin1_gate() == constGate() ) {
-         if ( !g->fanin1_inv() ) { 
-            // case1
-            mergeGate(constGate(), g, false);
-            fprintf(stdout, "Simplifying: %u merging %u...\n", constGate()->var(), g->var());
-         } else{ 
-            // case2
-            mergeGate(g->fanin0_gate(), g, g->fanin0_inv());
-            fprintf(stdout, "Simplifying: %u merging %s%u...\n", 
-               g->fanin0_gate()->var(), (g->fanin0_inv() ? "!" : ""), g->var());
+   CirGate* g = nullptr;
+   CirGateV result;
+   _msg.begin();
+   while (!qWork.empty()) {
+      g = _vAllGates[qWork.front()];
+      vQueued[qWork.front()] = false;
+      qWork.pop();
+      if (g == nullptr || !g->isAig()) continue;
+
+      const bool merged = opt_simplify(g, result);
+      if (!merged && !opt_rewrite(g)) continue;
+
+      // Fanouts may become simplifiable
+      for (unsigned i = 0, n = g->nFanouts(); i < n; ++i) {
+         CirGate* fo = g->fanout_gate(i);
+         if (fo->isAig() && visit.isVisited(fo) && !vQueued[fo->var()]) {
+            qWork.push(fo->var());
+            vQueued[fo->var()] = true;
          }
-      } else if ( g->fanin0_gate() == g->fanin1_gate() ) {
-         if ( g->fanin0_inv()  == g->fanin1_inv() ) { 
-            // case3
-            mergeGate(g->fanin0_gate(), g, g->fanin0_inv());
-            fprintf(stdout, "Simplifying: %u merging %s%u...\n", 
-               g->fanin0_gate()->var(), (g->fanin0_inv() ? "!" : ""), g->var());
-         } else { 
-            // case4
-            mergeGate(constGate(), g, false);
-            fprintf(stdout, "Simplifying: %u merging %u...\n", constGate()->var(), g->var());
+      }
+      if (merged) {
+         _msg.gate("Simplifying: %u merging %s%u...\n",
+            result.gate()->var(), (result.isInv() ? "!" : ""), g->var());
+         _msg.addItems();
+         mergeGate(result.gate(), g, result.isInv());
+      } else if (!vQueued[g->var()]) {
+         // Rewritten gate may be simplified again
+         qWork.push(g->var());
+         vQueued[g->var()] = true;
+      }
+   }
+   _msg.end("Simplifying", "merged");
+
+   // Update Lists
+   buildDfsList();
+   buildFloatingList();
+   buildUnusedList();
+   buildUndefList();
+   countAig();
+}
+
+// Rebuild every AND supergate as a balanced tree ordered by arrival level.
+// The reconstructed gates are strashed on the fly, and the internal gates
+// of a supergate are reused, so no new gate id is needed.
+// _dfsList needs to be reconstructed afterwards
+void
+CirMgr::balance()
+{
+   MyTraceScope trace("balance", "opt");
+   vector<unsigned> vLevel(_vAllGates.size(), 0);
+   const unsigned oriDepth = balance_calLevel(vLevel);
+
+   // Mark supergate roots. An AIG is absorbed into the supergate of its
+   // fanout only if it has exactly one fanout, which is a non-inverted AIG.
+   vector<CirGate*> vRoots;
+   CirVisit visit(_vAllGates.size());
+   for (unsigned i = 0, n = _vDfsList.size(); i < n; ++i) {
+      CirGate* g = _vDfsList[i];
+      if (!g->isAig()) continue;
+      if (g->nFanouts() == 1 && !g->fanout_inv(0) && g->fanout_gate(0)->isAig()) continue;
+      visit.visit(g);
+      vRoots.push_back(g);
+   }
+
+   HashMap<CirStrashK, CirGate*> hash;
+   hash.init(getHashSize(_vDfsList.size()));
+
+   vector<CirGate*> vNodes, vPool;
+   vector<CirGateV> vLeaves;
+   _msg.begin();
+   for (CirGate* root : vRoots) {
+      balance_collectSuperGate(root, visit, vNodes, vLeaves);
+
+      // Detach the supergate; internal gates (all but root) become free
+      for (CirGate* g : vNodes) {
+         g->fanin0_gate()->rmFanout(g);
+         g->fanin1_gate()->rmFanout(g);
+         if (g != root) g->clearFanout();
+      }
+      vPool.assign(vNodes.begin() + 1, vNodes.end());
+
+      const CirGateV result = balance_simplifyLeaves(vLeaves) 
+                            ? balance_buildTree(root, vPool, vLeaves, visit, vLevel, hash)
+                            : CirGateV(constGate(), 0);
+
+      // Root is not rebuilt (e.g. strashed or simplified), merge it
+      if (result.gate() != root) {
+         _msg.gate("Balancing: %u merging %s%u...\n",
+            result.gate()->var(), (result.isInv() ? "!" : ""), root->var());
+         _msg.addItems();
+         for (unsigned i = 0, n = root->nFanouts(); i < n; ++i) {
+            root->fanout_gate(i)->replaceFanin(result.gate(), root->fanout_inv(i) ^ result.isInv(), root);
+            result.gate()->addFanout(root->fanout_gate(i), root->fanout_inv(i) ^ result.isInv());
          }
-      } else {} // no optimization
+         delGate(root);
+      }
+      // Free gates left unused
+      for (CirGate* g : vPool)
+         delGate(g);
    }
+   _msg.end("Balancing", "merged");
 
    // Update Lists
    buildDfsList();
@@ -141,8 +224,203 @@ CirMgr::optimize()
    buildUnusedList();
    buildUndefList();
    countAig();
+
+   sortAllGateFanout();
+
+   const unsigned newDepth = balance_calLevel(vLevel);
+   _msg.summary("Balancing: logic depth %u -> %u\n", oriDepth, newDepth);
 }
 
 /***************************************************/
 /*   Private member functions about optimization   */
-/***************************************************/
\ No newline at end of file
+/***************************************************/
+// Return true if g can be replaced by 'result'.
+//    Case1: One of fanins is const0                 => const0
+//    Case2: One of fanins is const1                 => the other fanin
+//    Case3: Two fanins are the same (var) and phase => the fanin
+//    Case4: Two fanins are the same (var) but inv   => const0
+// Two-level cases, where y = (c & d) is an AIG fanin and x is the other:
+//    Case5: x &  (x & d) => y
+//    Case6: x &  (!x & d) => const0
+//    Case7: x & !(!x & d) => x
+//    Case8: (a & b) & (!a & c) => const0
+bool
+CirMgr::opt_simplify(CirGate* g, CirGateV& result) const
+{
+   const CirGateV f0 = g->fanin0(), f1 = g->fanin1();
+   const CirGateV const0(constGate(), 0), const1(constGate(), NEG);
+
+   // Case1 ~ Case4
+   if (f0 == const0 || f1 == const0) { result = const0; return true; }
+   if (f0 == const1) { result = f1; return true; }
+   if (f1 == const1) { result = f0; return true; }
+   if (f0 == f1) { result = f0; return true; }
+   if (f0.gate() == f1.gate()) { result = const0; return true; }
+
+   // Case5 ~ Case7
+   const CirGateV xy[2][2] = { { f0, f1 }, { f1, f0 } };
+   for (const auto& p : xy) {
+      const CirGateV& x = p[0];
+      const CirGateV& y = p[1];
+      if (!y.gate()->isAig()) continue;
+      const CirGateV c = y.gate()->fanin0(), d = y.gate()->fanin1();
+      const bool sameX = (c == x || d == x);
+      const bool invX  = (c.gate() == x.gate() && c != x) || (d.gate() == x.gate() && d != x);
+      if (!y.isInv()) {
+         if (sameX) { result = y;      return true; }
+         if (invX)  { result = const0; return true; }
+      } else {
+         if (invX)  { result = x;      return true; }
+      }
+   }
+
+   // Case8
+   if (!f0.isInv() && !f1.isInv() && f0.gate()->isAig() && f1.gate()->isAig()) {
+      const CirGateV a[2] = { f0.gate()->fanin0(), f0.gate()->fanin1() };
+      const CirGateV b[2] = { f1.gate()->fanin0(), f1.gate()->fanin1() };
+      for (const CirGateV& i : a)
+         for (const CirGateV& j : b)
+            if (i.gate() == j.gate() && i != j) { result = const0; return true; }
+   }
+   return false;
+}
+
+// Rewrite x & !(x & d) into x & !d in place; return true if rewritten.
+// (x & d) may become unused afterwards.
+bool
+CirMgr::opt_rewrite(CirGate* g)
+{
+   for (unsigned k = 0; k < 2; ++k) {
+      const CirGateV x = (k == 0 ? g->fanin1() : g->fanin0());
+      const CirGateV y = (k == 0 ? g->fanin0() : g->fanin1());
+      if (!y.isInv() || !y.gate()->isAig()) continue;
+
+      CirGateV d;
+      if (y.gate()->fanin0() == x)      d = y.gate()->fanin1();
+      else if (y.gate()->fanin1() == x) d = y.gate()->fanin0();
+      else continue;
+
+      const CirGateV newFanin(d.gate(), !d.isInv());
+      _msg.gate("Simplifying: %u rewriting fanin !%u to %s%u...\n", g->var(),
+         y.gate()->var(), (newFanin.isInv() ? "!" : ""), d.gate()->var());
+      y.gate()->rmFanout(g);
+      if (k == 0) g->setFanin0(newFanin);
+      else        g->setFanin1(newFanin);
+      d.gate()->addFanout(g, newFanin.isInv());
+      return true;
+   }
+   return false;
+}
+
+// Calculate the level of every gate in DFS list, indexed by var;
+// return the maximum level among POs
+unsigned
+CirMgr::balance_calLevel(vector<unsigned>& vLevel) const
+{
+   unsigned depth = 0;
+   fill(vLevel.begin(), vLevel.end(), 0);
+   for (unsigned i = 0, n = _vDfsList.size(); i < n; ++i) {
+      const CirGate* g = _vDfsList[i];
+      if (g->isAig()) {
+         vLevel[g->var()] = 1 + std::max(vLevel[g->fanin0_var()], vLevel[g->fanin1_var()]);
+      } else if (g->isPo()) {
+         vLevel[g->var()] = vLevel[g->fanin0_var()];
+         depth = std::max(depth, vLevel[g->var()]);
+      } else {}
+   }
+   return depth;
+}
+
+// Collect the supergate rooted at 'root'. vNodes[0] is always the root.
+// Gates marked in visit (supergate roots and rebuilt gates) are leaves.
+void
+CirMgr::balance_collectSuperGate(CirGate* root, const CirVisit& visit,
+                                 vector<CirGate*>& vNodes, vector<CirGateV>& vLeaves) const
+{
+   vNodes.clear();
+   vLeaves.clear();
+   vNodes.push_back(root);
+   for (unsigned i = 0; i < vNodes.size(); ++i) {
+      const CirGateV fanins[2] = { vNodes[i]->fanin0(), vNodes[i]->fanin1() };
+      for (const CirGateV& f : fanins) {
+         if (f.gate()->isAig() && !f.isInv() && !visit.isVisited(f.gate()))
+            vNodes.push_back(f.gate());
+         else
+            vLeaves.push_back(f);
+      }
+   }
+}
+
+// Remove duplicated and const1 leaves;
+// return false if the supergate is const0 (const0 leaf or x & !x)
+bool
+CirMgr::balance_simplifyLeaves(vector<CirGateV>& vLeaves) const
+{
+   std::sort(vLeaves.begin(), vLeaves.end(),
+      [] (const CirGateV& g1, const CirGateV& g2) {
+         return g1.gateV() < g2.gateV();
+      });
+   vLeaves.erase(std::unique(vLeaves.begin(), vLeaves.end()), vLeaves.end());
+   vLeaves.erase(remove(vLeaves.begin(), vLeaves.end(), CirGateV(constGate(), NEG)), vLeaves.end());
+   for (unsigned i = 0, n = vLeaves.size(); i < n; ++i) {
+      if (vLeaves[i].gate() == constGate()) return false;
+      if (i > 0 && vLeaves[i].gate() == vLeaves[i - 1].gate()) return false;
+   }
+   return true;
+}
+
+// Repeatedly AND the two earliest-arriving literals (Huffman-like).
+// The last AND gate is built on root, others on the free gates in vPool.
+CirGateV
+CirMgr::balance_buildTree(CirGate* root, vector<CirGate*>& vPool, vector<CirGateV>& vLeaves, CirVisit& visit,
+                          vector<unsigned>& vLevel, HashMap<CirStrashK, CirGate*>& hash)
+{
+   if (vLeaves.empty()) return CirGateV(constGate(), NEG);
+
+   // Min-heap on level; ties are broken by var for a deterministic result
+   auto later = [&vLevel] (const CirGateV& g1, const CirGateV& g2) {
+      const unsigned l1 = vLevel[g1.gate()->var()], l2 = vLevel[g2.gate()->var()];
+      if (l1 != l2) return l1 > l2;
+      if (g1.gate()->var() != g2.gate()->var()) return g1.gate()->var() > g2.gate()->var();
+      return g1.isInv() > g2.isInv();
+   };
+   priority_queue<CirGateV, vector<CirGateV>, decltype(later)> pq(later, vLeaves);
+
+   while (pq.size() > 1) {
+      const CirGateV a = pq.top(); pq.pop();
+      const CirGateV b = pq.top(); pq.pop();
+      CirGate* newGate = root;
+      if (!pq.empty()) {
+         assert(!vPool.empty());
+         newGate = vPool.back();
+      }
+      const CirGateV c = balance_and(a, b, newGate, visit, vLevel, hash);
+      if (c.gate() == newGate && newGate != root) vPool.pop_back();
+      pq.push(c);
+   }
+   return pq.top();
+}
+
+// Return the literal of (a & b); build it on newGate only if it is
+// neither trivially simplified nor already in the strash table
+CirGateV
+CirMgr::balance_and(const CirGateV& a, const CirGateV& b, CirGate* newGate, CirVisit& visit,
+                    vector<unsigned>& vLevel, HashMap<CirStrashK, CirGate*>& hash)
+{
+   if (a == b) return a;
+   if (a.gate() == b.gate()) return CirGateV(constGate(), 0);
+
+   const CirStrashK key(a, b);
+   CirGate* g = nullptr;
+   if (hash.check(key, g)) return CirGateV(g, 0);
+
+   assert(newGate != nullptr);
+   newGate->setFanin0(a);
+   newGate->setFanin1(b);
+   a.gate()->addFanout(newGate, a.isInv());
+   b.gate()->addFanout(newGate, b.isInv());
+   vLevel[newGate->var()] = 1 + std::max(vLevel[a.gate()->var()], vLevel[b.gate()->var()]);
+   visit.visit(newGate); // rebuilt, never absorbed again
+   hash.forceInsert(key, newGate);
+   return CirGateV(newGate, 0);
+}
@@ -6,26 +6,19 @@
   Date         [ 2018/1/17 created ]
 ****************************************************************************/
 
+#include <climits>
+#include <sstream>
 #include "cirMgr.h"
 #include "cirGate.h"
+#include "cirStrash.h"
 #include "util.h"
 
 using namespace std;
 
-/*******************************/
-/*   Global variable and enum  */
-/*******************************/
-extern unsigned lineNo = 0;  // in printint, lineNo needs to ++
-extern unsigned colNo = 0;   // in printing, colNo needs to ++
-extern char buf[1024];
-extern string errMsg;
-extern int errInt;
-extern CirGate *errGate;
-
 bool 
 CirMgr::parse_aag(ifstream& fin)
 {
-   lineNo = 0;
+   _lineNo = 0;
    string aagStr;
    fin >> aagStr;
    fin >> _maxIdx;
@@ -33,7 +26,7 @@ CirMgr::parse_aag(ifstream& fin)
    fin >> _nLATCH;
    fin >> _nPO;
    fin >> _nAIG;
-   ++lineNo;
+   ++_lineNo;
    parse_preprocess();
    return true;
 }
@@ -55,7 +48,7 @@ CirMgr::parse_pi(ifstream& fin)
    unsigned lit = 0;
    for (unsigned i = 0; i < _nPI; ++i) {
       fin >> lit;
-      newPiGate = new CirPiGate(++lineNo, VAR(lit));
+      newPiGate = new CirPiGate(++_lineNo, VAR(lit));
       _vAllGates[VAR(lit)] = newPiGate;
       _vPi.push_back(newPiGate);
    }
@@ -70,7 +63,7 @@ CirMgr::parse_po(ifstream& fin)
    unsigned lit = 0;
    for (unsigned i = 0; i < _nPO; ++i) {
       fin >> lit;
-      newPoGate = new CirPoGate(++lineNo, (_maxIdx + 1 + i));
+      newPoGate = new CirPoGate(++_lineNo, (_maxIdx + 1 + i));
       fanin = parse_queryGate(VAR(lit));
       newPoGate->setFanin0(fanin, INV(lit));
       fanin->addFanout(newPoGate, INV(lit));
@@ -93,11 +86,130 @@ CirMgr::parse_aig(ifstream& fin)
       g->setFanin1(f1, INV(f1_lit));
       f0->addFanout(g, INV(f0_lit));
       f1->addFanout(g, INV(f1_lit));
-      g->setLineNo(++lineNo);
+      g->setLineNo(++_lineNo);
    }
    return true;
 }
 
+// Read POs and AIGs, and build AIGs in topological order with strash
+// and trivial simplification. A merged AIG is never created, i.e.
+// _vAllGates[var] stays nullptr.
+bool 
+CirMgr::parse_strash(ifstream& fin)
+{
+   unsigned i;
+   const unsigned poLineNo = _lineNo + 1, aigLineNo = _lineNo + _nPO + 1;
+
+   // Read all literals first, AIGs may be defined out of order
+   vector<unsigned> vPoLit(_nPO), vAigLit(3 * _nAIG);
+   vector<unsigned> vDefIdx(_maxIdx + 1, UINT_MAX); // var -> index of AIG line
+   for (i = 0; i < _nPO; ++i)
+      fin >> vPoLit[i];
+   for (i = 0; i < _nAIG; ++i) {
+      fin >> vAigLit[3 * i] >> vAigLit[3 * i + 1] >> vAigLit[3 * i + 2];
+      vDefIdx[VAR(vAigLit[3 * i])] = i;
+   }
+   _lineNo += _nPO + _nAIG;
+
+   // Literal of every var after strash (null if not built yet)
+   vector<CirGateV> vVarLit(_maxIdx + 1);
+   vVarLit[0] = CirGateV(constGate(), 0);
+   for (i = 0; i < _nPI; ++i)
+      vVarLit[pi(i)->var()] = CirGateV(pi(i), 0);
+
+   HashMap<CirStrashK, CirGate*> hash;
+   hash.init(getHashSize(_nAIG));
+
+   // Build AIGs by iterative DFS, fanins first. The fanins of a var are
+   // pushed once (the var is then "in progress"); an in-progress var that
+   // is not built yet is on the current DFS path, so reaching it again
+   // from a fanin means a combinational loop.
+   unsigned nMerged = 0;
+   vector<unsigned> vStack;
+   vector<bool> vInProgress(_maxIdx + 1, false);
+   for (i = 0; i < _nAIG; ++i) {
+      vStack.push_back(VAR(vAigLit[3 * i]));
+      while (!vStack.empty()) {
+         const unsigned v = vStack.back();
+         if (!vVarLit[v].null()) { vStack.pop_back(); continue; }
+         const unsigned idx = vDefIdx[v];
+         if (!vInProgress[v]) {
+            vInProgress[v] = true;
+            bool bFaninReady = true;
+            for (unsigned k = 1; k <= 2; ++k) {
+               const unsigned f = VAR(vAigLit[3 * idx + k]);
+               if (vDefIdx[f] == UINT_MAX || !vVarLit[f].null()) continue;
+               if (vInProgress[f]) {
+                  _lineNo = aigLineNo + idx - 1;
+                  _errInt = vAigLit[3 * idx];
+                  return parse_error(COMB_LOOP);
+               }
+               vStack.push_back(f);
+               bFaninReady = false;
+            }
+            if (!bFaninReady) continue;
+         }
+         vStack.pop_back();
+
+         vVarLit[v] = parse_strashAig(v, parse_queryLit(vAigLit[3 * idx + 1], vVarLit),
+                                         parse_queryLit(vAigLit[3 * idx + 2], vVarLit), hash);
+         if (vVarLit[v].gate()->var() != v) ++nMerged;
+         else vVarLit[v].gate()->setLineNo(aigLineNo + idx);
+      }
+   }
+
+   // POs
+   CirPoGate* newPoGate = nullptr;
+   for (i = 0; i < _nPO; ++i) {
+      const CirGateV fanin = parse_queryLit(vPoLit[i], vVarLit);
+      newPoGate = new CirPoGate(poLineNo + i, (_maxIdx + 1 + i));
+      newPoGate->setFanin0(fanin);
+      fanin.gate()->addFanout(newPoGate, fanin.isInv());
+      _vAllGates[_maxIdx + 1 + i] = newPoGate;
+   }
+
+   if (nMerged > 0)
+      _msg.summary("Strashing: %u AIG(s) merged while reading...\n", nMerged);
+   return true;
+}
+
+// Return the AIG literal (f0 & f1). A new gate is created only if it can
+// be neither simplified trivially nor found in the strash table.
+CirGateV
+CirMgr::parse_strashAig(const unsigned gid, const CirGateV& f0, const CirGateV& f1,
+                        HashMap<CirStrashK, CirGate*>& hash)
+{
+   const CirGateV const0(constGate(), 0), const1(constGate(), NEG);
+   if (f0 == const0 || f1 == const0) return const0;
+   if (f0 == const1) return f1;
+   if (f1 == const1) return f0;
+   if (f0 == f1) return f0;
+   if (f0.gate() == f1.gate()) return const0;
+
+   const CirStrashK key(f0, f1);
+   CirGate* g = nullptr;
+   if (hash.check(key, g)) return CirGateV(g, 0);
+
+   g = new CirAigGate(0, gid);
+   _vAllGates[gid] = g;
+   g->setFanin0(f0);
+   g->setFanin1(f1);
+   f0.gate()->addFanout(g, f0.isInv());
+   f1.gate()->addFanout(g, f1.isInv());
+   hash.forceInsert(key, g);
+   return CirGateV(g, 0);
+}
+
+// Literal 'lit' after strash; an undefined var becomes an UNDEF gate
+CirGateV
+CirMgr::parse_queryLit(const unsigned lit, vector<CirGateV>& vVarLit)
+{
+   if (vVarLit[VAR(lit)].null())
+      vVarLit[VAR(lit)] = CirGateV(parse_queryGate(VAR(lit)), 0);
+   const CirGateV& v = vVarLit[VAR(lit)];
+   return CirGateV(v.gate(), v.isInv() ^ INV(lit));
+}
+
 bool 
 CirMgr::parse_symbol(ifstream& fin)
 {
@@ -138,3 +250,97 @@ CirMgr::parse_queryGate(const unsigned gid)
    _vAllGates[gid] = newGate;
    return _vAllGates[gid];
 }
+
+// Format the error into _errMsg
+bool
+CirMgr::parse_error(const CirParseError err)
+{
+   ostringstream os;
+   switch (err) {
+      case EXTRA_SPACE:
+         os << "[ERROR] Line " << _lineNo+1 << ", Col " << _colNo+1
+            << ": Extra space character is detected!!" << endl;
+         break;
+      case MISSING_SPACE:
+         os << "[ERROR] Line " << _lineNo+1 << ", Col " << _colNo+1
+            << ": Missing space character!!" << endl;
+         break;
+      case ILLEGAL_WSPACE: // for non-space white space character
+         os << "[ERROR] Line " << _lineNo+1 << ", Col " << _colNo+1
+            << ": Illegal white space char(" << _errInt
+            << ") is detected!!" << endl;
+         break;
+      case ILLEGAL_NUM:
+         os << "[ERROR] Line " << _lineNo+1 << ": Illegal "
+            << _errStr << "!!" << endl;
+         break;
+      case ILLEGAL_IDENTIFIER:
+         os << "[ERROR] Line " << _lineNo+1 << ": Illegal identifier \""
+            << _errStr << "\"!!" << endl;
+         break;
+      case ILLEGAL_SYMBOL_TYPE:
+         os << "[ERROR] Line " << _lineNo+1 << ", Col " << _colNo+1
+            << ": Illegal symbol type (" << _errStr << ")!!" << endl;
+         break;
+      case ILLEGAL_SYMBOL_NAME:
+         os << "[ERROR] Line " << _lineNo+1 << ", Col " << _colNo+1
+            << ": Symbolic name contains un-printable char(" << _errInt
+            << ")!!" << endl;
+         break;
+      case MISSING_NUM:
+         os << "[ERROR] Line " << _lineNo+1 << ", Col " << _colNo+1
+            << ": Missing " << _errStr << "!!" << endl;
+         break;
+      case MISSING_IDENTIFIER:
+         os << "[ERROR] Line " << _lineNo+1 << ": Missing \""
+            << _errStr << "\"!!" << endl;
+         break;
+      case MISSING_NEWLINE:
+         os << "[ERROR] Line " << _lineNo+1 << ", Col " << _colNo+1
+            << ": A new line is expected here!!" << endl;
+         break;
+      case MISSING_DEF:
+         os << "[ERROR] Line " << _lineNo+1 << ": Missing " << _errStr
+            << " definition!!" << endl;
+         break;
+      case CANNOT_INVERTED:
+         os << "[ERROR] Line " << _lineNo+1 << ", Col " << _colNo+1
+            << ": " << _errStr << " " << _errInt << "(" << _errInt/2
+            << ") cannot be inverted!!" << endl;
+         break;
+      case MAX_LIT_ID:
+         os << "[ERROR] Line " << _lineNo+1 << ", Col " << _colNo+1
+            << ": Literal \"" << _errInt << "\" exceeds maximum valid ID!!"
+            << endl;
+         break;
+      case REDEF_GATE:
+         os << "[ERROR] Line " << _lineNo+1 << ": Literal \"" << _errInt
+            << "\" is redefined, previously defined as "
+            << _errGate->getTypeStr() << " in line " << _errGate->getLineNo()
+            << "!!" << endl;
+         break;
+      case REDEF_SYMBOLIC_NAME:
+         os << "[ERROR] Line " << _lineNo+1 << ": Symbolic name for \""
+            << _errStr << _errInt << "\" is redefined!!" << endl;
+         break;
+      case REDEF_CONST:
+         os << "[ERROR] Line " << _lineNo+1 << ", Col " << _colNo+1
+            << ": Cannot redefine const (" << _errInt << ")!!" << endl;
+         break;
+      case NUM_TOO_SMALL:
+         os << "[ERROR] Line " << _lineNo+1 << ": " << _errStr
+            << " is too small (" << _errInt << ")!!" << endl;
+         break;
+      case NUM_TOO_BIG:
+         os << "[ERROR] Line " << _lineNo+1 << ": " << _errStr
+            << " is too big (" << _errInt << ")!!" << endl;
+         break;
+      case COMB_LOOP:
+         os << "[ERROR] Line " << _lineNo+1 << ": AIG \"" << _errInt
+            << "\" is in a combinational loop!!" << endl;
+         break;
+      default: break;
+   }
+   _errMsg = os.str();
+   return false;
+}
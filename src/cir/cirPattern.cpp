@@ -0,0 +1,218 @@
+/****************************************************************************
+  FileName     [ cirPattern.cpp ]
+  PackageName  [ cir ]
+  Synopsis     [ Define streaming reader of simulation pattern files ]
+  Author       [ agent ]
+  Date         [ 2026/10/18 created ]
+****************************************************************************/
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "cirPattern.h"
+
+using namespace std;
+
+/**************************************/
+/*   Static varaibles and functions   */
+/**************************************/
+static inline bool
+isSpace(const char c)
+{
+   return c == ' ' || c == '\n' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+}
+
+/*****************************************/
+/*   class CirPatternReader functions    */
+/*****************************************/
+CirPatternReader::CirPatternReader()
+   : _begin(nullptr), _end(nullptr), _pos(nullptr), _mapSize(0), _nPI(0),
+     _head(0), _nFull(0), _bDone(false), _bStop(false) {}
+
+CirPatternReader::~CirPatternReader()
+{
+   close();
+}
+
+bool
+CirPatternReader::open(const string& fileName)
+{
+   close();
+   const int fd = ::open(fileName.c_str(), O_RDONLY);
+   if (fd < 0) return false;
+
+   struct stat st;
+   if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0) {
+      void* p = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (p != MAP_FAILED) {
+         madvise(p, st.st_size, MADV_SEQUENTIAL);
+         _mapSize = st.st_size;
+         _begin = (const char*)p;
+         _end = _begin + _mapSize;
+      }
+   }
+   ::close(fd);
+
+   // Cannot be mapped (e.g. empty file or pipe) => read it at once
+   if (_mapSize == 0) {
+      ifstream fin(fileName.c_str());
+      if (!fin) return false;
+      stringstream ss;
+      ss << fin.rdbuf();
+      _content = ss.str();
+      _begin = _content.data();
+      _end = _begin + _content.size();
+   }
+   _pos = _begin;
+   return true;
+}
+
+void
+CirPatternReader::close()
+{
+   if (_producer.joinable()) {
+      {
+         lock_guard<mutex> lock(_mutex);
+         _bStop = true;
+      }
+      _cv.notify_all();
+      _producer.join();
+   }
+   if (_mapSize)
+      munmap((void*)_begin, _mapSize);
+   _begin = _end = _pos = nullptr;
+   _mapSize = 0;
+   _content.clear();
+   _head = _nFull = 0;
+   _bDone = _bStop = false;
+}
+
+void
+CirPatternReader::start(const unsigned nPI)
+{
+   _nPI = nPI;
+   _vRows.assign(((nPI + SIM_CYCLE - 1) / SIM_CYCLE) * SIM_CYCLE, 0);
+   for (unsigned i = 0; i < nBufs; ++i)
+      _bufs[i].model.resize(nPI);
+   _producer = thread(&CirPatternReader::produce, this);
+}
+
+unsigned
+CirPatternReader::next(CirModel& model, string& errMsg)
+{
+   unique_lock<mutex> lock(_mutex);
+   _cv.wait(lock, [this] { return _nFull > 0 || _bDone; });
+   if (_nFull == 0) return 0;
+
+   Batch& batch = _bufs[_head];
+   const unsigned nPatterns = batch.errMsg.empty() ? batch.nPatterns : 0;
+   model.swap(batch.model);
+   errMsg.swap(batch.errMsg);
+   batch.errMsg.clear();
+   _head = (_head + 1) % nBufs;
+   --_nFull;
+   lock.unlock();
+   _cv.notify_all();
+   return nPatterns;
+}
+
+// Producer thread
+void
+CirPatternReader::produce()
+{
+   unsigned tail = 0;
+   while (true) {
+      {
+         unique_lock<mutex> lock(_mutex);
+         _cv.wait(lock, [this] { return _nFull < nBufs || _bStop; });
+         if (_bStop) break;
+      }
+      // Only the producer touches a buffer which is not full
+      Batch& batch = _bufs[tail];
+      if (batch.model.size() != _nPI) batch.model.resize(_nPI);
+      const bool bMore = parse(batch);
+      {
+         lock_guard<mutex> lock(_mutex);
+         if (batch.nPatterns || !batch.errMsg.empty()) {
+            tail = (tail + 1) % nBufs;
+            ++_nFull;
+         }
+         if (!bMore) _bDone = true;
+      }
+      _cv.notify_all();
+      if (!bMore) break;
+   }
+}
+
+// Parse at most SIM_CYCLE patterns into 'batch'.
+// Return false if no more pattern should be parsed.
+bool
+CirPatternReader::parse(Batch& batch)
+{
+   batch.nPatterns = 0;
+   batch.errMsg.clear();
+   fill(_vRows.begin(), _vRows.end(), 0);
+
+   const char* p = _pos;
+   bool bMore = true;
+   while (batch.nPatterns < SIM_CYCLE) {
+      while (p != _end && isSpace(*p)) ++p;
+      if (p == _end) { bMore = false; break; }
+      const char* tok = p;
+      while (p != _end && !isSpace(*p)) ++p;
+      if (!parsePattern(tok, p - tok, batch.nPatterns, batch.errMsg)) {
+         bMore = false;
+         break;
+      }
+      ++batch.nPatterns;
+   }
+   _pos = p;
+
+   // Transpose each 64x64 block: pattern-major => PI-major
+   for (unsigned b = 0, n = _vRows.size(); b < n; b += SIM_CYCLE) {
+      bitTranspose64(&_vRows[b]);
+      for (unsigned i = b, e = min(b + (unsigned)SIM_CYCLE, _nPI); i < e; ++i)
+         batch.model[i] = _vRows[i];
+   }
+   return bMore;
+}
+
+// Pack a pattern into bit 'pos'-th row of each block
+bool
+CirPatternReader::parsePattern(const char* tok, const unsigned len, const unsigned pos, string& errMsg)
+{
+   // Error Handling:
+   //    1. Length of pattern string == nPI
+   //    2. Pattern string consists of '0' or '1'.
+   //
+   if (len != _nPI) {
+      errMsg = "\nError: Pattern(" + string(tok, len) + ") length(" + to_string(len) 
+             + ") does not match the number of inputs(" + to_string(_nPI) + ") in a circuit!!\n";
+      return false;
+   }
+
+   // 8 chars at a time: check they are all '0'/'1', then gather their LSBs
+   const size_t ONES = 0x0101010101010101ULL;
+   unsigned i = 0;
+   for (; i + 8 <= len; i += 8) {
+      size_t v;
+      memcpy(&v, tok + i, 8);
+      if ((v & ~ONES) != 0x3030303030303030ULL) break;
+      const size_t bits = ((v & ONES) * 0x0102040810204080ULL) >> 56;
+      _vRows[(i / SIM_CYCLE) * SIM_CYCLE + pos] |= bits << (i % SIM_CYCLE);
+   }
+   for (; i < len; ++i) {
+      if (tok[i] != '0' && tok[i] != '1') {
+         errMsg = "\nError: Pattern(" + string(tok, len) + ") contains a non-0/1 character(\'" + tok[i] + "\').\n";
+         return false;
+      }
+      if (tok[i] == '1')
+         _vRows[(i / SIM_CYCLE) * SIM_CYCLE + pos] |= CONST1 << (i % SIM_CYCLE);
+   }
+   return true;
+}
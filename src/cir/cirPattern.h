@@ -0,0 +1,81 @@
+/****************************************************************************
+  FileName     [ cirPattern.h ]
+  PackageName  [ cir ]
+  Synopsis     [ Streaming reader of simulation pattern files ]
+  Author       [ agent ]
+  Date         [ 2026/10/18 created ]
+****************************************************************************/
+
+#ifndef CIRPATTERN_H
+#define CIRPATTERN_H
+
+#include <string>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include "cirDef.h"
+#include "cirModel.h"
+
+using namespace std;
+
+// Read a pattern file (one pattern of '0'/'1' per token) and deliver
+// the patterns SIM_CYCLE at a time as bit-parallel CirModels.
+//
+// The file is mmap'ed (or read at once if it cannot be mapped). A
+// producer thread parses and transposes the next batch while the caller
+// simulates the current one (double buffered).
+class CirPatternReader
+{
+public:
+   CirPatternReader();
+   ~CirPatternReader();
+
+   bool open(const string& fileName);
+
+   // Start the producer thread, each pattern should have 'nPI' bits
+   void start(const unsigned nPI);
+
+   // Move the next batch to 'model'. Return the number of patterns in it,
+   // 0 if no pattern is left. If a pattern is invalid, the error message
+   // is stored in 'errMsg', and the patterns before it in the same batch
+   // are not returned.
+   unsigned next(CirModel& model, string& errMsg);
+
+private:
+   // A batch of (at most SIM_CYCLE) patterns
+   struct Batch {
+      CirModel model;
+      unsigned nPatterns;
+      string   errMsg;
+   };
+   static const unsigned nBufs = 2;
+
+   // Memory of the file
+   const char*     _begin;
+   const char*     _end;
+   const char*     _pos;
+   size_t          _mapSize;
+   string          _content;   // used if the file cannot be mapped
+
+   // Parsing
+   unsigned        _nPI;
+   vector<size_t>  _vRows;     // pattern-major bits, 64 x 64 blocks
+
+   // Producer / consumer
+   thread                 _producer;
+   mutex                  _mutex;
+   condition_variable     _cv;
+   Batch                  _bufs[nBufs];
+   unsigned               _head;      // next buffer to consume
+   unsigned               _nFull;     // number of filled buffers
+   bool                   _bDone;     // no more batch will be produced
+   bool                   _bStop;     // ask the producer to quit
+
+   void     produce();
+   bool     parse(Batch& batch);
+   bool     parsePattern(const char* tok, const unsigned len, const unsigned pos, string& errMsg);
+   void     close();
+};
+
+#endif // CIRPATTERN_H
@@ -12,6 +12,7 @@
 #include <algorithm>
 #include <cassert>
 #include <cmath>
+#include <chrono>
 #include "cirMgr.h"
 #include "cirGate.h"
 #include "util.h"
@@ -33,21 +34,22 @@ using namespace std;
 /************************************************/
 /*   Public member functions about Simulation   */
 /************************************************/
-void
-CirMgr::randomSim()
+unsigned
+CirMgr::randomSim(const size_t seed, CirSimStop* stop, const bool doReport)
 {
-   // Tuned parameter 'max_fail':
-   //   If #FECgroups remains the same continually 'max_fail' times,
-   //   then stop random simulation.
-   const unsigned max_fail  = 3 + 3 * log10((double)_vDfsList.size());
+   CirSimStopGrp defaultStop;
+   if (!stop) stop = &defaultStop;
+   stop->reset(_vDfsList.size());
 
-   unsigned nPatterns = 0; // accumulate number of sim patterns
-   unsigned nFail = 0; // fail to make #fecGrps change
-   unsigned nOldGrps = 0; // previous #FEC group
+   CirSimEffort effort;
+   const auto start = chrono::steady_clock::now();
 
-   CirModel model(_nPI);
+   // Before the first simulation, the const gate and all AIGs are in one group
+   unsigned nOldPending = _bFirstSim ? _fecGrps.nCands() - _fecGrps.nGrps() : _nDfsAIG;
+
+   CirModel model(_nPI, seed);
 
-   while (nFail < max_fail) {
+   do {
       // Randomly generate patterns
       model.random();
 
@@ -57,238 +59,196 @@ CirMgr::randomSim()
       // Write to the output file _simLog
       sim_writeSimLog(SIM_CYCLE);
 
-      sim_printMsg_totalFecGrp();
-      nPatterns += SIM_CYCLE;
+      // Update effort info
+      ++effort.nRounds;
+      effort.nPatterns += SIM_CYCLE;
+      effort.nGrps = _fecGrps.nGrps();
+      effort.nCands = _fecGrps.nCands();
+      effort.nRefined = nOldPending > effort.nPending() ? nOldPending - effort.nPending() : 0;
+      effort.seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+      nOldPending = effort.nPending();
 
-      // Update termination info
-      nFail = (nOldGrps == _lFecGrps.size() ? (nFail + 1) : 0);
-      nOldGrps = _lFecGrps.size();
-   }
+      if (doReport) sim_printMsg_effort(effort);
+      else sim_printMsg_totalFecGrp();
+   } while (!stop->stop(effort));
 
    sim_sortFecGrps_var();
-   sim_linkGrp2Gate();
 
-   cout << flush << "\r" << nPatterns << " patterns simulated." << endl;
+   _msg.clearTick();
+   _msg.summary("\r%u patterns simulated.\n", effort.nPatterns);
+   return effort.nPatterns;
 }
 
-void
-CirMgr::fileSim(ifstream& patternFile)
+unsigned
+CirMgr::fileSim(CirPatternReader& patternFile)
 {
-   unsigned periodCnt = 0; // SIM_CYCLE, a period
    unsigned nPatterns = 0;
-   string patternStr;
+   unsigned periodCnt = 0; // number of patterns in this period (<= SIM_CYCLE)
+   string errMsg;
 
    CirModel model(_nPI);
 
-   while (true) {
-
-      if ( !(patternFile >> patternStr) ) {
-         // simulate here one more time, then break
-         if (periodCnt != 0) {
-            // Simulate the circuit
-            sim_simulation(model);
-
-            // Write to the output file _simLog
-            sim_writeSimLog(periodCnt);
-            sim_printMsg_totalFecGrp();
-            nPatterns += periodCnt;
-         }
-         break;
-      }
-
-      // Check if pattern is valid
-      if (!sim_checkPattern(patternStr)) break;
-
-      // Set pattern value to model
-      model.setPattern(patternStr, periodCnt++);
-
-      // Simulate immediately, if 64 patterns are collected.
-      if (periodCnt == SIM_CYCLE) {
-         sim_simulation(model);
-         sim_writeSimLog(periodCnt);
-         sim_printMsg_totalFecGrp();
-         nPatterns += periodCnt;
-         periodCnt = 0;
-         model.reset();
-      }
+   // The next batch is parsed by the reader while this one is simulated
+   patternFile.start(_nPI);
+   while ((periodCnt = patternFile.next(model, errMsg)) != 0) {
+      sim_simulation(model);
+      sim_writeSimLog(periodCnt);
+      sim_printMsg_totalFecGrp();
+      nPatterns += periodCnt;
    }
+   // Invalid pattern: the patterns before it in the same period are not simulated
+   if (!errMsg.empty())
+      fprintf(stderr, "%s", errMsg.c_str());
 
    sim_sortFecGrps_var();
-   sim_linkGrp2Gate();
    
-   cout << flush << "\r" << nPatterns << " patterns simulated." << endl;
+   _msg.clearTick();
+   _msg.summary("\r%u patterns simulated.\n", nPatterns);
+   return nPatterns;
 }
 
-/*************************************************/
-/*   Private member functions about Simulation   */
-/*************************************************/
-bool
-CirMgr::sim_checkPattern(const string& patternStr)
+// Log is written by a background thread until it is reset (logFile = 0)
+void
+CirMgr::setSimLog(ofstream *logFile, const bool bBinary)
 {
-   // Error Handling:
-   //    1. Length of pattern string == nPI
-   //    2. Pattern string consists of '0' or '1'.
-   // 
-   // 1. Length check
-   if (patternStr.length() != _nPI) {
-      fprintf(stderr, "\nError: Pattern(%s) length(%lu) does not match the number of inputs(%u) in a circuit!!\n", 
-         patternStr.c_str(), patternStr.length(), _nPI);
-      return false;
-   }
-   // 2. Char check
-   for (unsigned i = 0, n = patternStr.length(); i < n; ++i) {
-      if (patternStr[i] != '0' && patternStr[i] != '1') {
-         fprintf(stderr, "\nError: Pattern(%s) contains a non-0/1 character(\'%c\').\n", 
-            patternStr.c_str(), patternStr[i]);
-         return false;
-      }
-   } 
-   return true;
+   _simLogWriter.close();
+   _simLog = logFile;
+   if (_simLog)
+      _simLogWriter.open(_simLog, _nPI, _nPO, bBinary);
 }
 
+/*************************************************/
+/*   Private member functions about Simulation   */
+/*************************************************/
 void 
 CirMgr::sim_simulation(const CirModel& model) 
 {
+   MyTraceScope trace("simRound", "sim");
+
    // Set simulation patterns to PIs
    for (unsigned i = 0, n = model.size(); i < n; ++i)
       pi(i)->setValue(model[i]);
 
    // Calculate sim value of every gate in DFS list
+   const CirStatTimer calValueTimer(_stat.enabled());
    for (unsigned i = 0, n = _vDfsList.size(); i < n; ++i)
       _vDfsList[i]->calValue();
+   const double calValueSec = calValueTimer.seconds();
 
    // Classify gates into FEC groups
+   const CirStatTimer classifyTimer(_stat.enabled());
    if (!_bFirstSim) {
       sim_firstClassifyFecGrp();
       _bFirstSim = true;
    } else {
       sim_classifyFecGrp();
    }
+   _stat.addSimRound(calValueSec, classifyTimer.seconds());
+   trace.arg("nGrps", _fecGrps.nGrps());
+   if (myTrace.isOpen()) myTrace.counter("#FEC Group", "nGrps", _fecGrps.nGrps());
 }
 
 void 
 CirMgr::sim_firstClassifyFecGrp()
 {
+   // Put the const gate and all AIGs in DFS list into one group, then split it.
+   // The phase of each candidate is its LSB, so complemented values are
+   // normalized to the same signature.
    CirGate* g = nullptr;
-   CirFecGrp* queryGrp = nullptr;
-   HashMap<CirInitSimValue, CirFecGrp*> hash;
-   forward_list<CirFecGrp*> flCandGrp;
-   hash.init(getHashSize(_vDfsList.size()));
+   _fecGrps.clear();
+   _fecGrps.reserve(_nDfsAIG + 1);
 
    // Const gate (must be inside whether it is in dfsList or not)
-   queryGrp = new CirFecGrp;
-   flCandGrp.push_front(queryGrp);
-   queryGrp->emplace_back(constGate());
-   hash.forceInsert(CirInitSimValue(constGate()->value()), queryGrp);
-   
+   _fecGrps.emplace_back(constGate(), constGate()->value() & CONST1);
+
    // Aig gates
-   for (unsigned i = 0, n = _vDfsList.size(); i < n && (g = _vDfsList[i]); ++i) {
-      // Skip non-AIG gates
-      if (!g->isAig()) continue;
-      if (hash.check(CirInitSimValue(g->value()), queryGrp)) {
-         queryGrp->emplace_back(g, g->value() != queryGrp->repValue());
-      } else {
-         queryGrp = new CirFecGrp;
-         flCandGrp.push_front(queryGrp);
-         queryGrp->emplace_back(g);
-         hash.forceInsert(CirInitSimValue(g->value()), queryGrp);
-      }
-   }
+   for (unsigned i = 0, n = _vDfsList.size(); i < n && (g = _vDfsList[i]); ++i)
+      if (g->isAig())
+         _fecGrps.emplace_back(g, g->value() & CONST1);
 
-   // Collect valid FEc group from hash
-   for (auto iter2 = flCandGrp.begin(); iter2 != flCandGrp.end(); ++iter2)
-      if ((*iter2)->isValid())
-         _lFecGrps.push_front(*iter2);
-      else
-         delete *iter2;
+   _fecGrps.closeGrp();
+   sim_classifyFecGrp();
 }
 
 void 
 CirMgr::sim_classifyFecGrp()
 {
-   unsigned i, n;
-   size_t value, oriValue;
-   CirGate *g;
-   CirFecGrp *queryGrp, *oriGrp;
-   forward_list<CirFecGrp*> flCandGrp;
-   HashMap<CirSimValue, CirFecGrp*> hash;
-
-   for (auto iter = _lFecGrps.begin(); iter != _lFecGrps.end(); iter = _lFecGrps.erase(iter)) {
-
-      flCandGrp.clear();
+   vector<pair<size_t, unsigned> > vKeys;
+   CirFecPartition newGrps;
+   newGrps.reserve(_fecGrps.nCands());
 
-      oriGrp = *iter;
-      hash.init(getHashSize(oriGrp->size()));
+   for (unsigned g = 0, n = _fecGrps.nGrps(); g < n; ++g)
+      sim_splitFecGrp(g, vKeys, newGrps);
 
-      for (i = 0, n = oriGrp->size(); i < n && (g = oriGrp->candGate(i)); ++i) {
+   _fecGrps.swap(newGrps);
+}
 
-         oriValue = g->value();
-         value = oriGrp->candInv(i) ? ~oriValue : oriValue;
+// Split group g by the phase-normalized signatures of its candidates.
+//    1. Sort (signature, position) pairs, so equal signatures become
+//       consecutive runs and each run keeps the original order.
+//    2. Append every run to 'newGrps' as a group; singletons are dropped.
+// Lazy deleted candidates (already merged by fraig) are dropped as well.
+// Group links are updated by 'newGrps' only for gates that moved.
+void
+CirMgr::sim_splitFecGrp(const unsigned g, vector<pair<size_t, unsigned> >& vKeys, 
+                        CirFecPartition& newGrps) const
+{
+   CirGate* c = nullptr;
+   vKeys.clear();
+   for (unsigned i = _fecGrps.grpBegin(g), n = _fecGrps.grpEnd(g); i < n; ++i)
+      if ((c = _fecGrps.candGate(i)))
+         vKeys.emplace_back(_fecGrps.candInv(g, i) ? ~c->value() : c->value(), i);
+   std::sort(vKeys.begin(), vKeys.end());
+
+   for (unsigned begin = 0, end = 0, n = vKeys.size(); begin < n; begin = end) {
+      while (end < n && vKeys[end].first == vKeys[begin].first) ++end;
+      // Singleton: no longer in any group
+      if (end - begin < 2) {
+         CirFecPartition::unlink(_fecGrps.candGate(vKeys[begin].second));
+         continue;
+      }
 
-         if (hash.check(CirSimValue(value), queryGrp)) {
-            queryGrp->emplace_back(g, oriValue != queryGrp->repValue());
-         } else {
-            queryGrp = new CirFecGrp;
-            queryGrp->emplace_back(g);
-            hash.forceInsert(CirSimValue(oriValue, oriGrp->candInv(i)), queryGrp);
-            flCandGrp.push_front(queryGrp);
-         }
+      // The first candidate of a run is its representative (phase 0)
+      const bool repInv = _fecGrps.candInv(g, vKeys[begin].second);
+      for (unsigned j = begin; j < end; ++j) {
+         const unsigned i = vKeys[j].second;
+         newGrps.emplace_back(_fecGrps.candGate(i), _fecGrps.candInv(g, i) ^ repInv);
       }
-      delete *iter;
-
-      // Collect valid FEC groups (i.e. size > 1)
-      for (auto iter2 = flCandGrp.begin(); iter2 != flCandGrp.end(); ++iter2)
-         if ((*iter2)->isValid())
-            _lFecGrps.push_front(*iter2);
-         else
-            delete *iter2;
+      newGrps.closeGrp();
    }
 }
 
 void 
 CirMgr::sim_sortFecGrps_var()
 {
-   for (CirFecGrp* grp : _lFecGrps)
-      grp->sort();
-
-   _lFecGrps.sort(
-      [] (const CirFecGrp* g1, const CirFecGrp* g2) {
-         return g1->repVar() < g2->repVar();
-      });
+   _fecGrps.sort();
 }
 
 void 
-CirMgr::sim_linkGrp2Gate()
-{  
-   for (unsigned i = 0, n = _vAllGates.size(); i < n; ++i) {
-      if (_vAllGates[i])
-         _vAllGates[i]->setGrp(nullptr);
-   }
-   for (CirFecGrp* grp : _lFecGrps) {
-      for (unsigned i = 0, n = grp->size(); i < n; ++i) {
-         grp->candGate(i)->setGrp(grp);
-         grp->candGate(i)->setGrpIdx(i);
-      }
-   }
+CirMgr::sim_writeSimLog(const unsigned nPatterns)
+{
+   if (!_simLog) return;
+   vector<size_t>& vWords = _simLogWriter.words();
+   for (unsigned j = 0; j < _nPI; ++j)
+      vWords[j] = pi(j)->value();
+   for (unsigned j = 0; j < _nPO; ++j)
+      vWords[_nPI + j] = po(j)->value();
+   _simLogWriter.commit(nPatterns);
 }
 
 void 
-CirMgr::sim_writeSimLog(const unsigned nPatterns) const
+CirMgr::sim_printMsg_effort(const CirSimEffort& e) const
 {
-   if (!_simLog) return;
-   unsigned i, j;
-   for (i = 0; i < nPatterns; ++i) {
-      for (j = 0; j < _nPI; ++j)
-         *_simLog << pi(j)->value(i);
-      *_simLog << ' ';
-      for (j = 0; j < _nPO; ++j)
-         *_simLog << po(j)->value(i);
-      *_simLog << endl;
-   }
+   fprintf(stdout, "Round %u: %u patterns, #FEC Group = %u, #Cand = %u, refined %u (%.2f s)\n",
+      e.nRounds, e.nPatterns, e.nGrps, e.nCands, e.nRefined, e.seconds);
 }
 
 void 
 CirMgr::sim_printMsg_totalFecGrp() const
 {
-   cout << flush << "\rTotal #FEC Group = " << _lFecGrps.size();
+   if (!_msg.isFull()) {
+      _msg.tick("Total #FEC Group = %u", _fecGrps.nGrps());
+      return;
+   }
+   cout << flush << "\rTotal #FEC Group = " << _fecGrps.nGrps();
 }
\ No newline at end of file
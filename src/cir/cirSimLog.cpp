@@ -0,0 +1,186 @@
+/****************************************************************************
+  FileName     [ cirSimLog.cpp ]
+  PackageName  [ cir ]
+  Synopsis     [ Define buffered writer of simulation logs ]
+  Author       [ agent ]
+  Date         [ 2026/10/18 created ]
+****************************************************************************/
+
+#include <cstring>
+#include <cstdint>
+#include "cirSimLog.h"
+#include "cirModel.h"
+
+using namespace std;
+
+/**************************************/
+/*   Static varaibles and functions   */
+/**************************************/
+// 8 bits => 8 chars of '0'/'1', LSB first
+// Built once, thread-safe (static local initialization)
+static const uint64_t*
+charTable()
+{
+   struct Table {
+      uint64_t t[256];
+      Table() {
+         for (unsigned b = 0; b < 256; ++b) {
+            char c[8];
+            for (unsigned k = 0; k < 8; ++k)
+               c[k] = ((b >> k) & 1) ? '1' : '0';
+            memcpy(&t[b], c, 8);
+         }
+      }
+   };
+   static const Table table;
+   return table.t;
+}
+
+// Append the low nBytes bytes of v, least significant byte first
+static inline void
+appendLE(string& buf, const uint64_t v, const unsigned nBytes)
+{
+   char b[8];
+   for (unsigned k = 0; k < nBytes; ++k)
+      b[k] = (char)(v >> (8 * k));
+   buf.append(b, nBytes);
+}
+
+/****************************************/
+/*   class CirSimLogWriter functions    */
+/****************************************/
+void
+CirSimLogWriter::open(ostream* os, const unsigned nPI, const unsigned nPO, const bool bBinary)
+{
+   close();
+   _os = os;
+   _nPI = nPI;
+   _nPO = nPO;
+   _bBinary = bBinary;
+   _vWords.assign(nPI + nPO, 0);
+   _buf.clear();
+   _buf.reserve(bufSize + 4096);
+   _bStop = false;
+
+   charTable();
+   if (_bBinary) {
+      _buf.append("SIMLOG1\n", 8);
+      appendLE(_buf, nPI, 4);
+      appendLE(_buf, nPO, 4);
+   }
+   _writer = thread(&CirSimLogWriter::write, this);
+}
+
+void
+CirSimLogWriter::commit(const unsigned nPatterns)
+{
+   unique_lock<mutex> lock(_mutex);
+   _cv.wait(lock, [this] { return _pending.size() < maxPending; });
+   _pending.emplace_back();
+   Period& p = _pending.back();
+   if (!_free.empty()) {
+      p.words.swap(_free.back());
+      _free.pop_back();
+   }
+   p.words.swap(_vWords);
+   p.nPatterns = nPatterns;
+   _vWords.resize(_nPI + _nPO);
+   lock.unlock();
+   _cv.notify_all();
+}
+
+void
+CirSimLogWriter::close()
+{
+   if (!_os) return;
+   {
+      lock_guard<mutex> lock(_mutex);
+      _bStop = true;
+   }
+   _cv.notify_all();
+   _writer.join();
+   _os = nullptr;
+}
+
+// Background thread
+void
+CirSimLogWriter::write()
+{
+   while (true) {
+      unique_lock<mutex> lock(_mutex);
+      _cv.wait(lock, [this] { return !_pending.empty() || _bStop; });
+      if (_pending.empty()) break;   // stopped and nothing left
+      Period p;
+      p.words.swap(_pending.front().words);
+      p.nPatterns = _pending.front().nPatterns;
+      _pending.pop_front();
+      lock.unlock();
+      _cv.notify_all();
+
+      format(p);
+      if (_buf.size() >= bufSize) flush();
+
+      lock.lock();
+      _free.emplace_back();
+      _free.back().swap(p.words);
+   }
+   flush();
+   _os->flush();
+}
+
+void
+CirSimLogWriter::format(const Period& p)
+{
+   if (_bBinary) {
+      appendLE(_buf, p.nPatterns, 4);
+      for (const size_t w : p.words)
+         appendLE(_buf, w, 8);
+      return;
+   }
+
+   // Reserve the lines of this period, then fill PI and PO columns
+   const unsigned lineLen = _nPI + _nPO + 2;
+   const size_t start = _buf.size();
+   _buf.resize(start + (size_t)p.nPatterns * lineLen);
+   for (unsigned i = 0; i < p.nPatterns; ++i) {
+      char* line = &_buf[start + (size_t)i * lineLen];
+      line[_nPI] = ' ';
+      line[lineLen - 1] = '\n';
+   }
+   formatText(p.words.data(), _nPI, p.nPatterns, 0, lineLen);
+   formatText(p.words.data() + _nPI, _nPO, p.nPatterns, _nPI + 1, lineLen);
+}
+
+// Transpose 'n' words (one per PI/PO) into chars at column 'col' of each line
+void
+CirSimLogWriter::formatText(const size_t* words, const unsigned n, const unsigned nPatterns,
+                            const unsigned col, const unsigned lineLen)
+{
+   const uint64_t* table = charTable();
+   char* base = &_buf[_buf.size() - (size_t)nPatterns * lineLen];
+   _vRows.resize(SIM_CYCLE);
+   for (unsigned b = 0; b < n; b += SIM_CYCLE) {
+      const unsigned nBits = min((unsigned)SIM_CYCLE, n - b);
+      copy(words + b, words + b + nBits, _vRows.begin());
+      fill(_vRows.begin() + nBits, _vRows.end(), 0);
+      bitTranspose64(_vRows.data());
+
+      for (unsigned i = 0; i < nPatterns; ++i) {
+         char* out = base + (size_t)i * lineLen + col + b;
+         const size_t row = _vRows[i];
+         unsigned k = 0;
+         for (; k + 8 <= nBits; k += 8)
+            memcpy(out + k, &table[(row >> k) & 0xff], 8);
+         for (; k < nBits; ++k)
+            out[k] = ((row >> k) & 1) ? '1' : '0';
+      }
+   }
+}
+
+void
+CirSimLogWriter::flush()
+{
+   if (_buf.empty()) return;
+   _os->write(_buf.data(), _buf.size());
+   _buf.clear();
+}
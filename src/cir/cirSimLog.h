@@ -0,0 +1,80 @@
+/****************************************************************************
+  FileName     [ cirSimLog.h ]
+  PackageName  [ cir ]
+  Synopsis     [ Buffered writer of simulation logs ]
+  Author       [ agent ]
+  Date         [ 2026/10/18 created ]
+****************************************************************************/
+
+#ifndef CIRSIMLOG_H
+#define CIRSIMLOG_H
+
+#include <vector>
+#include <deque>
+#include <string>
+#include <ostream>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include "cirDef.h"
+
+using namespace std;
+
+// Write simulation results of a period (at most SIM_CYCLE patterns).
+// The words of PIs and POs are handed over to a background thread, which
+// formats them and writes a large buffer at a time (no flush per line).
+//
+// Text format: one line per pattern, "<PI bits> <PO bits>\n".
+// Binary format (all integers little endian, whatever the host is):
+//    "SIMLOG1\n", uint32 nPI, uint32 nPO,
+//    then for each period: uint32 nPatterns, nPI uint64 PI words,
+//    nPO uint64 PO words (bit i of a word is the value of pattern i).
+class CirSimLogWriter
+{
+public:
+   CirSimLogWriter() : _os(nullptr), _nPI(0), _nPO(0), _bBinary(false), _bStop(false) {}
+   ~CirSimLogWriter() { close(); }
+
+   void open(ostream* os, const unsigned nPI, const unsigned nPO, const bool bBinary);
+   bool isOpen() const { return _os != nullptr; }
+
+   // Buffer of (nPI + nPO) words to be filled by the caller, then commit()
+   vector<size_t>& words() { return _vWords; }
+   void commit(const unsigned nPatterns);
+
+   // Write all pending periods and stop the background thread
+   void close();
+
+private:
+   struct Period {
+      vector<size_t> words;
+      unsigned       nPatterns;
+   };
+   static const unsigned maxPending = 4;
+   static const size_t   bufSize = 1 << 20;
+
+   ostream*             _os;
+   unsigned             _nPI;
+   unsigned             _nPO;
+   bool                 _bBinary;
+   vector<size_t>       _vWords;
+
+   // Background thread
+   thread               _writer;
+   mutex                _mutex;
+   condition_variable   _cv;
+   deque<Period>        _pending;
+   vector<vector<size_t> > _free;     // recycled word buffers
+   bool                 _bStop;
+
+   // Used by the background thread only
+   string               _buf;
+   vector<size_t>       _vRows;
+
+   void write();
+   void format(const Period& p);
+   void formatText(const size_t* words, const unsigned n, const unsigned nPatterns, const unsigned col, const unsigned lineLen);
+   void flush();
+};
+
+#endif // CIRSIMLOG_H
@@ -0,0 +1,118 @@
+/****************************************************************************
+  FileName     [ cirSimStop.h ]
+  PackageName  [ cir ]
+  Synopsis     [ Stopping policies of random simulation ]
+  Author       [ agent ]
+  Date         [ 2026/10/18 created ]
+****************************************************************************/
+
+#ifndef CIRSIMSTOP_H
+#define CIRSIMSTOP_H
+
+#include <cmath>
+
+using namespace std;
+
+class CirSimEffort;
+class CirSimStop;
+class CirSimStopGrp;
+class CirSimStopRefine;
+
+// Effort of random simulation, updated after every round
+class CirSimEffort
+{
+public:
+   CirSimEffort() : nRounds(0), nPatterns(0), nGrps(0), nCands(0),
+                    nRefined(0), seconds(0.0) {}
+
+   // Number of candidates that can still be merged, i.e. sum of (size - 1)
+   unsigned nPending() const { return nCands - nGrps; }
+
+   unsigned nRounds;    // number of simulated rounds
+   unsigned nPatterns;  // number of simulated patterns
+   unsigned nGrps;      // number of FEC groups
+   unsigned nCands;     // number of candidates in all FEC groups
+   unsigned nRefined;   // number of candidates refined by the last round
+   double   seconds;    // elapsed time
+};
+
+// Base class of stopping policies.
+// Pattern and time budgets (0: unlimited) apply to every policy.
+class CirSimStop
+{
+public:
+   CirSimStop() : _maxPatterns(0), _maxSeconds(0.0) {}
+   virtual ~CirSimStop() {}
+
+   void setMaxPatterns(const unsigned n) { _maxPatterns = n; }
+   void setMaxSeconds(const double s) { _maxSeconds = s; }
+
+   // Called once before the first round
+   virtual void reset(const unsigned dfsSize) = 0;
+
+   // Called after every round
+   bool stop(const CirSimEffort& e) {
+      if (_maxPatterns && e.nPatterns >= _maxPatterns) return true;
+      if (_maxSeconds > 0.0 && e.seconds >= _maxSeconds) return true;
+      return stopCriterion(e);
+   }
+
+protected:
+   virtual bool stopCriterion(const CirSimEffort& e) = 0;
+
+   // Tuned parameter 'max_fail':
+   //   Give up after 'max_fail' unproductive rounds in a row.
+   static unsigned maxFail(const unsigned dfsSize) {
+      return 3 + 3 * log10((double)dfsSize);
+   }
+
+   unsigned _maxPatterns;
+   double   _maxSeconds;
+};
+
+// Stop if #FECgroups remains the same continually 'max_fail' times
+class CirSimStopGrp : public CirSimStop
+{
+public:
+   void reset(const unsigned dfsSize) {
+      _maxFail = maxFail(dfsSize);
+      _nFail = 0;
+      _nOldGrps = 0;
+   }
+
+protected:
+   bool stopCriterion(const CirSimEffort& e) {
+      _nFail = (_nOldGrps == e.nGrps ? (_nFail + 1) : 0);
+      _nOldGrps = e.nGrps;
+      return _nFail >= _maxFail;
+   }
+
+private:
+   unsigned _maxFail;
+   unsigned _nFail;
+   unsigned _nOldGrps;
+};
+
+// Stop if no candidate is refined continually 'max_fail' times.
+// Unlike CirSimStopGrp, it keeps going while candidates are split off
+// even if #FECgroups does not change.
+class CirSimStopRefine : public CirSimStop
+{
+public:
+   void reset(const unsigned dfsSize) {
+      _maxFail = maxFail(dfsSize);
+      _nFail = 0;
+   }
+
+protected:
+   bool stopCriterion(const CirSimEffort& e) {
+      _nFail = (e.nRefined == 0 ? (_nFail + 1) : 0);
+      return _nFail >= _maxFail;
+   }
+
+private:
+   unsigned _maxFail;
+   unsigned _nFail;
+};
+
+#endif // CIRSIMSTOP_H
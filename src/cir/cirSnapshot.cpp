@@ -0,0 +1,435 @@
+/****************************************************************************
+  FileName     [ cirSnapshot.cpp ]
+  PackageName  [ cir ]
+  Synopsis     [ Save and load the full state of CirMgr in binary ]
+  Author       [ agent ]
+  Date         [ 2026/10/18 created ]
+****************************************************************************/
+
+#include <cstdio>
+#include <cstring>
+#include <cassert>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "cirMgr.h"
+#include "cirGate.h"
+#include "cirSnapshot.h"
+#include "util.h"
+
+using namespace std;
+
+/**************************************/
+/*   Static varaibles and functions   */
+/**************************************/
+static const char snapMagic[8] = "CIRSNAP";
+
+static inline size_t
+snapAlign(const size_t n)
+{
+   return (n + 7) & ~size_t(7);
+}
+
+static inline uint32_t
+snapLit(const CirGateV& g)
+{
+   return g.null() ? CIR_SNAP_NULL_LIT : LIT(g.gate()->var(), (uint32_t)g.isInv());
+}
+
+static void
+snapVars(const vector<CirGate*>& vGates, vector<uint32_t>& vVars)
+{
+   vVars.resize(vGates.size());
+   for (size_t i = 0, n = vGates.size(); i < n; ++i)
+      vVars[i] = vGates[i]->var();
+}
+
+/**************************************/
+/*   class CirSnapWriter              */
+/**************************************/
+// Written to a temporary file, then renamed, so an interrupted write
+// (e.g. a killed job) never leaves a broken file behind
+bool
+CirSnapWriter::write(const string& fileName, CirSnapHeader header) const
+{
+   const string tmpName = fileName + ".tmp";
+   FILE* f = fopen(tmpName.c_str(), "wb");
+   if (!f) return false;
+
+   memcpy(header.magic, snapMagic, sizeof(header.magic));
+   header.version = CIR_SNAP_VERSION;
+   header.byteOrder = CIR_SNAP_BYTEORDER;
+   header.simBits = SIM_CYCLE;
+   header.nSections = _vSections.size();
+
+   vector<CirSnapEntry> vEntries(_vSections.size());
+   size_t offset = snapAlign(sizeof(header) + vEntries.size() * sizeof(CirSnapEntry));
+   for (size_t i = 0, n = _vSections.size(); i < n; ++i) {
+      const Section& s = _vSections[i];
+      vEntries[i] = { s.id, (uint32_t)s.itemSize, offset, s.nItems };
+      offset = snapAlign(offset + s.itemSize * s.nItems);
+   }
+
+   static const char zeros[8] = {};
+   bool bOk = fwrite(&header, sizeof(header), 1, f) == 1;
+   if (!vEntries.empty())
+      bOk = bOk && fwrite(vEntries.data(), sizeof(CirSnapEntry), vEntries.size(), f) == vEntries.size();
+   size_t pos = sizeof(header) + vEntries.size() * sizeof(CirSnapEntry);
+   for (size_t i = 0, n = _vSections.size(); bOk && i < n; ++i) {
+      const size_t bytes = _vSections[i].itemSize * _vSections[i].nItems;
+      bOk = fwrite(zeros, 1, vEntries[i].offset - pos, f) == vEntries[i].offset - pos;
+      if (bOk && bytes) bOk = fwrite(_vSections[i].data, 1, bytes, f) == bytes;
+      pos = vEntries[i].offset + bytes;
+   }
+   // Pad the last section, so every section ends inside the file
+   if (bOk) bOk = fwrite(zeros, 1, offset - pos, f) == offset - pos;
+   if (fclose(f) != 0) bOk = false;
+   if (bOk) bOk = rename(tmpName.c_str(), fileName.c_str()) == 0;
+   if (!bOk) remove(tmpName.c_str());
+   return bOk;
+}
+
+/**************************************/
+/*   class CirSnapReader              */
+/**************************************/
+bool
+CirSnapReader::open(const string& fileName, string& errMsg)
+{
+   close();
+   const int fd = ::open(fileName.c_str(), O_RDONLY);
+   if (fd < 0) {
+      errMsg = "Cannot open snapshot \"" + fileName + "\"!!\n";
+      return false;
+   }
+   struct stat st;
+   if (fstat(fd, &st) < 0 || (size_t)st.st_size < sizeof(CirSnapHeader)) {
+      ::close(fd);
+      errMsg = "\"" + fileName + "\" is not a snapshot!!\n";
+      return false;
+   }
+   void* p = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+   ::close(fd);
+   if (p == MAP_FAILED) {
+      errMsg = "Cannot map snapshot \"" + fileName + "\"!!\n";
+      return false;
+   }
+   _base = (const char*)p;
+   _size = st.st_size;
+
+   // Check the header and the section table, so section() is always safe
+   const CirSnapHeader& h = header();
+   if (memcmp(h.magic, snapMagic, sizeof(h.magic)) != 0) {
+      errMsg = "\"" + fileName + "\" is not a snapshot!!\n";
+      close();
+      return false;
+   }
+   if (h.byteOrder != CIR_SNAP_BYTEORDER || h.version != CIR_SNAP_VERSION || h.simBits != SIM_CYCLE) {
+      errMsg = "Snapshot \"" + fileName + "\" is written by an incompatible build!!\n";
+      close();
+      return false;
+   }
+   bool bOk = sizeof(CirSnapHeader) + (uint64_t)h.nSections * sizeof(CirSnapEntry) <= _size;
+   const CirSnapEntry* vEntries = (const CirSnapEntry*)(_base + sizeof(CirSnapHeader));
+   for (uint32_t i = 0; bOk && i < h.nSections; ++i) {
+      const CirSnapEntry& e = vEntries[i];
+      bOk = e.offset % 8 == 0 && e.offset <= _size && e.itemSize > 0 &&
+            e.nItems <= (_size - e.offset) / e.itemSize;
+   }
+   if (!bOk) {
+      errMsg = "Snapshot \"" + fileName + "\" is truncated or corrupted!!\n";
+      close();
+      return false;
+   }
+   return true;
+}
+
+void
+CirSnapReader::close()
+{
+   if (_base) munmap((void*)_base, _size);
+   _base = nullptr;
+   _size = 0;
+}
+
+const CirSnapEntry*
+CirSnapReader::entry(const unsigned id) const
+{
+   const CirSnapEntry* vEntries = (const CirSnapEntry*)(_base + sizeof(CirSnapHeader));
+   for (uint32_t i = 0; i < header().nSections; ++i)
+      if (vEntries[i].id == id) return &vEntries[i];
+   return nullptr;
+}
+
+/**************************************************/
+/*   class CirMgr member functions for snapshot   */
+/**************************************************/
+bool
+CirMgr::saveSnapshot(const string& fileName, const unsigned flowState) const
+{
+   MyTraceScope trace("saveSnapshot", "cir");
+   CirSnapWriter writer;
+   CirSnapBuf buf;
+   snap_addSections(writer, buf);
+   return snap_write(writer, fileName, flowState);
+}
+
+bool
+CirMgr::loadSnapshot(const string& fileName, unsigned& flowState)
+{
+   MyTraceScope trace("loadSnapshot", "cir");
+   CirSnapReader reader;
+   if (!reader.open(fileName, _errMsg)) return false;
+   if (!snap_restore(reader) || !snap_restoreFraig(reader)) {
+      _errMsg = "Snapshot \"" + fileName + "\" is truncated or corrupted!!\n";
+      return false;
+   }
+   flowState = reader.header().flowState;
+   return true;
+}
+
+/***************************************************/
+/*   Private member functions about snapshot       */
+/***************************************************/
+bool
+CirMgr::snap_write(const CirSnapWriter& writer, const string& fileName, const unsigned flowState) const
+{
+   CirSnapHeader header = CirSnapHeader();
+   header.flowState = flowState;
+   header.maxIdx = _maxIdx;
+   header.nPI = _nPI;
+   header.nLATCH = _nLATCH;
+   header.nPO = _nPO;
+   header.nAIG = _nAIG;
+   header.nDfsAIG = _nDfsAIG;
+   header.bFirstSim = _bFirstSim;
+   return writer.write(fileName, header);
+}
+
+// The sections point into 'b', so it must outlive the writer
+void
+CirMgr::snap_addSections(CirSnapWriter& writer, CirSnapBuf& b) const
+{
+   const size_t nGates = _vAllGates.size();
+   b.vType.assign(nGates, SNAP_GATE_NONE);
+   b.vLineNo.assign(nGates, 0);
+   b.vDfsOrder.assign(nGates, 0);
+   b.vValue.assign(nGates, 0);
+   b.vFanin.assign(2 * nGates, CIR_SNAP_NULL_LIT);
+   b.vFanoutOfs.assign(nGates + 1, 0);
+   b.vFanout.clear();
+   for (size_t v = 0; v < nGates; ++v) {
+      const CirGate* g = _vAllGates[v];
+      b.vFanoutOfs[v] = b.vFanout.size();
+      if (!g) continue;
+      b.vType[v] = g->isConst() ? SNAP_GATE_CONST : g->isPi() ? SNAP_GATE_PI :
+                   g->isPo() ? SNAP_GATE_PO : g->isUndef() ? SNAP_GATE_UNDEF : SNAP_GATE_AIG;
+      b.vLineNo[v] = g->lineNo();
+      b.vDfsOrder[v] = g->dfsOrder();
+      b.vValue[v] = g->value();
+      b.vFanin[2 * v] = snapLit(g->fanin0());
+      b.vFanin[2 * v + 1] = snapLit(g->fanin1());
+      for (unsigned i = 0, n = g->nFanouts(); i < n; ++i)
+         b.vFanout.push_back(snapLit(g->fanout(i)));
+   }
+   b.vFanoutOfs[nGates] = b.vFanout.size();
+
+   snapVars(_vPi, b.vPi);
+   b.vSymbolOfs.assign(1, 0);
+   b.vSymbol.clear();
+   for (unsigned i = 0; i < _nPI + _nPO; ++i) {
+      const string s = i < _nPI ? pi(i)->symbol() : po(i - _nPI)->symbol();
+      b.vSymbol.insert(b.vSymbol.end(), s.begin(), s.end());
+      b.vSymbolOfs.push_back(b.vSymbol.size());
+   }
+
+   b.vFecCand.resize(_fecGrps.nCands());
+   for (unsigned i = 0, n = _fecGrps.nCands(); i < n; ++i)
+      b.vFecCand[i] = snapLit(_fecGrps.cand(i));
+   b.vFecOfs.resize(_fecGrps.nGrps() + 1);
+   for (unsigned g = 0, n = _fecGrps.nGrps(); g <= n; ++g)
+      b.vFecOfs[g] = g < n ? _fecGrps.grpBegin(g) : _fecGrps.nCands();
+
+   snapVars(_vDfsList, b.vDfs);
+   snapVars(_vFloatingList, b.vFloating);
+   snapVars(_vUnusedList, b.vUnused);
+   snapVars(_vUndefList, b.vUndef);
+
+   writer.add(SNAP_GATE_TYPE, b.vType);
+   writer.add(SNAP_LINENO, b.vLineNo);
+   writer.add(SNAP_DFSORDER, b.vDfsOrder);
+   writer.add(SNAP_VALUE, b.vValue);
+   writer.add(SNAP_FANIN, b.vFanin);
+   writer.add(SNAP_FANOUT_OFS, b.vFanoutOfs);
+   writer.add(SNAP_FANOUT, b.vFanout);
+   writer.add(SNAP_PI, b.vPi);
+   writer.add(SNAP_SYMBOL_OFS, b.vSymbolOfs);
+   writer.add(SNAP_SYMBOL, b.vSymbol);
+   writer.add(SNAP_FEC_CAND, b.vFecCand);
+   writer.add(SNAP_FEC_OFS, b.vFecOfs);
+   writer.add(SNAP_DFS, b.vDfs);
+   writer.add(SNAP_FLOATING, b.vFloating);
+   writer.add(SNAP_UNUSED, b.vUnused);
+   writer.add(SNAP_UNDEF, b.vUndef);
+}
+
+// Rebuild the netlist from a snapshot; return false if it is inconsistent.
+// The CirMgr must be newly constructed (as for readCircuit()).
+bool
+CirMgr::snap_restore(const CirSnapReader& reader)
+{
+   const CirSnapHeader& h = reader.header();
+   const size_t nGates = (size_t)h.maxIdx + 1 + h.nPO;
+   size_t n[SNAP_REQUIRED_TOT] = {};
+   const uint8_t*  vType      = reader.section<uint8_t>(SNAP_GATE_TYPE, n[SNAP_GATE_TYPE]);
+   const uint32_t* vLineNo    = reader.section<uint32_t>(SNAP_LINENO, n[SNAP_LINENO]);
+   const uint32_t* vDfsOrder  = reader.section<uint32_t>(SNAP_DFSORDER, n[SNAP_DFSORDER]);
+   const uint64_t* vValue     = reader.section<uint64_t>(SNAP_VALUE, n[SNAP_VALUE]);
+   const uint32_t* vFanin     = reader.section<uint32_t>(SNAP_FANIN, n[SNAP_FANIN]);
+   const uint64_t* vFanoutOfs = reader.section<uint64_t>(SNAP_FANOUT_OFS, n[SNAP_FANOUT_OFS]);
+   const uint32_t* vFanout    = reader.section<uint32_t>(SNAP_FANOUT, n[SNAP_FANOUT]);
+   const uint32_t* vPi        = reader.section<uint32_t>(SNAP_PI, n[SNAP_PI]);
+   const uint64_t* vSymbolOfs = reader.section<uint64_t>(SNAP_SYMBOL_OFS, n[SNAP_SYMBOL_OFS]);
+   const char*     vSymbol    = reader.section<char>(SNAP_SYMBOL, n[SNAP_SYMBOL]);
+   const uint32_t* vFecCand   = reader.section<uint32_t>(SNAP_FEC_CAND, n[SNAP_FEC_CAND]);
+   const uint32_t* vFecOfs    = reader.section<uint32_t>(SNAP_FEC_OFS, n[SNAP_FEC_OFS]);
+   if (!vType || !vLineNo || !vDfsOrder || !vValue || !vFanin || !vFanoutOfs || !vFanout ||
+       !vPi || !vSymbolOfs || !vSymbol || !vFecCand || !vFecOfs)
+      return false;
+   if (n[SNAP_GATE_TYPE] != nGates || n[SNAP_LINENO] != nGates || n[SNAP_DFSORDER] != nGates ||
+       n[SNAP_VALUE] != nGates || n[SNAP_FANIN] != 2 * nGates || n[SNAP_FANOUT_OFS] != nGates + 1 ||
+       vFanoutOfs[nGates] != n[SNAP_FANOUT] || n[SNAP_PI] != h.nPI ||
+       n[SNAP_SYMBOL_OFS] != (size_t)h.nPI + h.nPO + 1 || vSymbolOfs[h.nPI + h.nPO] != n[SNAP_SYMBOL] ||
+       n[SNAP_FEC_OFS] == 0 || vFecOfs[0] != 0 || vFecOfs[n[SNAP_FEC_OFS] - 1] != n[SNAP_FEC_CAND])
+      return false;
+
+   _maxIdx = h.maxIdx;
+   _nPI = h.nPI;
+   _nLATCH = h.nLATCH;
+   _nPO = h.nPO;
+   _nAIG = h.nAIG;
+   _nDfsAIG = h.nDfsAIG;
+   _bFirstSim = h.bFirstSim;
+
+   // Gates
+   _vAllGates.assign(nGates, nullptr);
+   for (size_t v = 0; v < nGates; ++v) {
+      CirGate* g = nullptr;
+      switch (vType[v]) {
+         case SNAP_GATE_NONE:  continue;
+         case SNAP_GATE_CONST: g = new CirConstGate; break;
+         case SNAP_GATE_PI:    g = new CirPiGate(vLineNo[v], v); break;
+         case SNAP_GATE_PO:    g = new CirPoGate(vLineNo[v], v); break;
+         case SNAP_GATE_AIG:
+         case SNAP_GATE_UNDEF: g = new CirAigGate(vLineNo[v], v); break;
+         default: return false;
+      }
+      if (g->isConst() != (v == 0) || g->isPo() != (v > _maxIdx)) {
+         delete g;
+         return false;
+      }
+      g->setDfsOrder(vDfsOrder[v]);
+      g->setValue(vValue[v]);
+      _vAllGates[v] = g;
+   }
+   if (!_vAllGates[0]) return false;
+
+   // Literal to CirGateV; null if the lit is illegal
+   auto gateV = [this, nGates] (const uint32_t lit) -> CirGateV {
+      const uint32_t v = VAR(lit);
+      return v < nGates && _vAllGates[v] ? CirGateV(_vAllGates[v], INV(lit)) : CirGateV();
+   };
+
+   // Fanins and fanouts
+   for (size_t v = 0; v < nGates; ++v) {
+      CirGate* g = _vAllGates[v];
+      if (!g) continue;
+      for (unsigned k = 0; k < 2; ++k) {
+         const uint32_t lit = vFanin[2 * v + k];
+         if (lit == CIR_SNAP_NULL_LIT) continue;
+         const CirGateV f = gateV(lit);
+         if (f.null()) return false;
+         if (k == 0) g->setFanin0(f);
+         else g->setFanin1(f);
+      }
+      if ((vType[v] == SNAP_GATE_AIG && g->isUndef()) || (vType[v] == SNAP_GATE_UNDEF && !g->isUndef()))
+         return false;
+      if (vFanoutOfs[v] > vFanoutOfs[v + 1] || vFanoutOfs[v + 1] > n[SNAP_FANOUT]) return false;
+      for (uint64_t i = vFanoutOfs[v]; i < vFanoutOfs[v + 1]; ++i) {
+         const CirGateV f = gateV(vFanout[i]);
+         if (f.null()) return false;
+         g->addFanout(f);
+      }
+   }
+
+   // PIs and symbols
+   _vPi.resize(_nPI);
+   for (unsigned i = 0; i < _nPI; ++i) {
+      if (vPi[i] >= nGates || !_vAllGates[vPi[i]] || !_vAllGates[vPi[i]]->isPi()) return false;
+      _vPi[i] = _vAllGates[vPi[i]];
+   }
+   for (unsigned i = 0; i < _nPO; ++i)
+      if (!_vAllGates[_maxIdx + 1 + i]) return false;
+   for (unsigned i = 0; i < _nPI + _nPO; ++i) {
+      if (vSymbolOfs[i] > vSymbolOfs[i + 1] || vSymbolOfs[i + 1] > n[SNAP_SYMBOL]) return false;
+      const string s(vSymbol + vSymbolOfs[i], vSymbol + vSymbolOfs[i + 1]);
+      if (i < _nPI) pi(i)->setSymbol(s);
+      else po(i - _nPI)->setSymbol(s);
+   }
+
+   // FEC groups
+   _fecGrps.clear();
+   _fecGrps.reserve(n[SNAP_FEC_CAND]);
+   for (size_t g = 0; g + 1 < n[SNAP_FEC_OFS]; ++g) {
+      if (vFecOfs[g] > vFecOfs[g + 1] || vFecOfs[g + 1] - vFecOfs[g] < 2) return false;
+      for (uint32_t i = vFecOfs[g]; i < vFecOfs[g + 1]; ++i) {
+         const CirGateV c = gateV(vFecCand[i]);
+         if (c.null() || c.gate()->grp() != NULL_GRP) return false;
+         _fecGrps.emplace_back(c.gate(), c.isInv());
+      }
+      _fecGrps.closeGrp();
+   }
+
+   // Lists
+   const CirSnapSection listIds[] = { SNAP_DFS, SNAP_FLOATING, SNAP_UNUSED, SNAP_UNDEF };
+   vector<CirGate*>* lists[] = { &_vDfsList, &_vFloatingList, &_vUnusedList, &_vUndefList };
+   for (unsigned k = 0; k < 4; ++k) {
+      size_t nVars = 0;
+      const uint32_t* vVars = reader.section<uint32_t>(listIds[k], nVars);
+      if (!vVars) return false;
+      lists[k]->resize(nVars);
+      for (size_t i = 0; i < nVars; ++i) {
+         if (vVars[i] >= nGates || !_vAllGates[vVars[i]]) return false;
+         (*lists[k])[i] = _vAllGates[vVars[i]];
+      }
+   }
+   return true;
+}
+
+// Fraig progress of a checkpoint, if any
+bool
+CirMgr::snap_restoreFraig(const CirSnapReader& reader)
+{
+   _fraigProgress = CirFraigProgress();
+   size_t nFraig = 0, nMergeLits = 0, nModel = 0;
+   const CirSnapFraig* f = reader.section<CirSnapFraig>(SNAP_FRAIG, nFraig);
+   if (!f) return true;
+   const uint32_t* vMergeLits = reader.section<uint32_t>(SNAP_FRAIG_MERGE, nMergeLits);
+   const uint64_t* vModel = reader.section<uint64_t>(SNAP_FRAIG_MODEL, nModel);
+   if (nFraig != 1 || !vMergeLits || nMergeLits % 2 || !vModel || nModel != _nPI ||
+       f->startDfsId > _vDfsList.size() || f->periodCnt > SIM_CYCLE)
+      return false;
+   // (alive, dead): only the alive gate may be the const gate
+   for (size_t i = 0; i < nMergeLits; ++i) {
+      const CirGate* g = getGate(VAR(vMergeLits[i]));
+      if (!g || !(g->isAig() || (i % 2 == 0 && g->isConst()))) return false;
+   }
+
+   _fraigProgress.bValid = true;
+   _fraigProgress.startDfsId = f->startDfsId;
+   _fraigProgress.periodCnt = f->periodCnt;
+   _fraigProgress.unsatMergeRatio = f->unsatMergeRatio;
+   _fraigProgress.vMergeLits.assign(vMergeLits, vMergeLits + nMergeLits);
+   _fraigProgress.vModel.assign(vModel, vModel + nModel);
+   return true;
+}
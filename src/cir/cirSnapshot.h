@@ -0,0 +1,186 @@
+/****************************************************************************
+  FileName     [ cirSnapshot.h ]
+  PackageName  [ cir ]
+  Synopsis     [ Define the binary snapshot file of CirMgr ]
+  Author       [ agent ]
+  Date         [ 2026/10/18 created ]
+****************************************************************************/
+
+#ifndef CIRSNAPSHOT_H
+#define CIRSNAPSHOT_H
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// A snapshot file is a header, a section table, then the sections.
+// Every section is an array of fixed-size items starting at an 8-byte
+// boundary, so the reader uses the mmapped file in place. Integers are
+// in the native byte order; a file of another byte order is rejected.
+// Gates are referred to by literals (2 * var + inv).
+
+constexpr uint32_t CIR_SNAP_VERSION  = 1;
+constexpr uint32_t CIR_SNAP_BYTEORDER = 0x01020304;
+constexpr uint32_t CIR_SNAP_NULL_LIT = (~0u);   // null CirGateV
+
+enum CirSnapGateType
+{
+   SNAP_GATE_NONE,   // var not used
+   SNAP_GATE_CONST,
+   SNAP_GATE_PI,
+   SNAP_GATE_PO,
+   SNAP_GATE_AIG,
+   SNAP_GATE_UNDEF
+};
+
+enum CirSnapSection
+{
+   SNAP_GATE_TYPE,   // uint8_t  [nGates], CirSnapGateType
+   SNAP_LINENO,      // uint32_t [nGates]
+   SNAP_DFSORDER,    // uint32_t [nGates]
+   SNAP_VALUE,       // uint64_t [nGates], simulation values
+   SNAP_FANIN,       // uint32_t [2 * nGates], literals
+   SNAP_FANOUT_OFS,  // uint64_t [nGates + 1], fanouts of var v in [ofs[v], ofs[v+1])
+   SNAP_FANOUT,      // uint32_t [], literals in the order of the gates
+   SNAP_PI,          // uint32_t [nPI], vars of _vPi
+   SNAP_SYMBOL_OFS,  // uint64_t [nPI + nPO + 1], PI symbols then PO symbols
+   SNAP_SYMBOL,      // char     []
+   SNAP_FEC_CAND,    // uint32_t [], literals of _fecGrps
+   SNAP_FEC_OFS,     // uint32_t [nGrps + 1]
+   SNAP_DFS,         // uint32_t [], vars of the lists
+   SNAP_FLOATING,
+   SNAP_UNUSED,
+   SNAP_UNDEF,
+
+   // Optional sections start here (readers skip unknown ones)
+   SNAP_REQUIRED_TOT,
+
+   // Checkpoint of fraig (see CirFraigProgress)
+   SNAP_FRAIG = SNAP_REQUIRED_TOT,   // CirSnapFraig [1]
+   SNAP_FRAIG_MERGE,                 // uint32_t [2 * #pairs], literals (alive, dead)
+   SNAP_FRAIG_MODEL                  // uint64_t [nPI], counterexamples not simulated yet
+};
+
+struct CirSnapHeader
+{
+   char     magic[8];     // "CIRSNAP"
+   uint32_t version;
+   uint32_t byteOrder;    // CIR_SNAP_BYTEORDER
+   uint32_t simBits;      // bits of a simulation value
+   uint32_t flowState;    // not used by CirMgr (e.g. the state of cir commands)
+   uint32_t maxIdx;
+   uint32_t nPI;
+   uint32_t nLATCH;
+   uint32_t nPO;
+   uint32_t nAIG;
+   uint32_t nDfsAIG;
+   uint32_t bFirstSim;
+   uint32_t nSections;
+};
+
+struct CirSnapEntry
+{
+   uint32_t id;           // CirSnapSection
+   uint32_t itemSize;
+   uint64_t offset;       // from the beginning of the file
+   uint64_t nItems;
+};
+
+struct CirSnapFraig
+{
+   uint32_t startDfsId;
+   uint32_t periodCnt;
+   double   unsatMergeRatio;
+};
+
+// Progress of fraig(), saved in a checkpoint with the snapshot.
+// The netlist is not changed by the pending merges yet; their dead gates
+// are already out of the FEC groups. The pass in progress is resumed at
+// _vDfsList[startDfsId]: the gates before it are only added to the SAT
+// solver again.
+struct CirFraigProgress
+{
+   CirFraigProgress() : bValid(false), startDfsId(0), periodCnt(0), unsatMergeRatio(0.0) {}
+
+   bool             bValid;
+   unsigned         startDfsId;
+   unsigned         periodCnt;         // #patterns in vModel
+   double           unsatMergeRatio;
+   vector<uint32_t> vMergeLits;        // pending vMergePairs
+   vector<uint64_t> vModel;
+};
+
+// Arrays of the sections of CirMgr::saveSnapshot()
+struct CirSnapBuf
+{
+   vector<uint8_t>  vType;
+   vector<uint32_t> vLineNo;
+   vector<uint32_t> vDfsOrder;
+   vector<uint64_t> vValue;
+   vector<uint32_t> vFanin;
+   vector<uint64_t> vFanoutOfs;
+   vector<uint32_t> vFanout;
+   vector<uint32_t> vPi;
+   vector<uint64_t> vSymbolOfs;
+   vector<char>     vSymbol;
+   vector<uint32_t> vFecCand;
+   vector<uint32_t> vFecOfs;
+   vector<uint32_t> vDfs;
+   vector<uint32_t> vFloating;
+   vector<uint32_t> vUnused;
+   vector<uint32_t> vUndef;
+};
+
+// Sections are kept as pointers: the data must stay alive until write()
+class CirSnapWriter
+{
+public:
+   template<class T> void add(const unsigned id, const vector<T>& v) {
+      add(id, v.data(), sizeof(T), v.size());
+   }
+   void add(const unsigned id, const void* data, const size_t itemSize, const size_t nItems) {
+      _vSections.push_back({ id, data, itemSize, nItems });
+   }
+   bool write(const string& fileName, CirSnapHeader header) const;
+
+private:
+   struct Section {
+      unsigned     id;
+      const void*  data;
+      size_t       itemSize;
+      size_t       nItems;
+   };
+   vector<Section> _vSections;
+};
+
+// The file is mapped read-only until close()
+class CirSnapReader
+{
+public:
+   CirSnapReader() : _base(nullptr), _size(0) {}
+   ~CirSnapReader() { close(); }
+
+   bool open(const string& fileName, string& errMsg);
+   void close();
+
+   const CirSnapHeader& header() const { return *(const CirSnapHeader*)_base; }
+
+   // Return nullptr if the section is missing or its items are not T
+   template<class T> const T* section(const unsigned id, size_t& nItems) const {
+      const CirSnapEntry* e = entry(id);
+      if (!e || e->itemSize != sizeof(T)) return nullptr;
+      nItems = e->nItems;
+      return (const T*)(_base + e->offset);
+   }
+
+private:
+   const CirSnapEntry* entry(const unsigned id) const;
+
+   const char*   _base;
+   size_t        _size;
+};
+
+#endif // CIRSNAPSHOT_H
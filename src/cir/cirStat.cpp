@@ -0,0 +1,60 @@
+/****************************************************************************
+  FileName     [ cirStat.cpp ]
+  PackageName  [ cir ]
+  Synopsis     [ Define reports of phase counters ]
+  Author       [ agent ]
+  Date         [ 2026/10/18 created ]
+****************************************************************************/
+
+#include <cstdio>
+#include <algorithm>
+#include "cirStat.h"
+
+using namespace std;
+
+/*******************************/
+/*   class CirStat functions   */
+/*******************************/
+void
+CirStat::printSim() const
+{
+   const double total = _calValueTime + _classifyTime;
+   fprintf(stdout, "Simulation: %u round(s)", _nSimRounds);
+   if (_nResimRounds) fprintf(stdout, " (%u by counter-examples)", _nResimRounds);
+   fprintf(stdout, "\n");
+   fprintf(stdout, "   calValue : %.3f s (%.1f%%)\n", _calValueTime, total > 0.0 ? 100.0 * _calValueTime / total : 0.0);
+   fprintf(stdout, "   classify : %.3f s (%.1f%%)\n", _classifyTime, total > 0.0 ? 100.0 * _classifyTime / total : 0.0);
+}
+
+void
+CirStat::printFraig() const
+{
+   static const char* resultStr[] = { "SAT", "UNSAT", "Undecided" };
+   unsigned nCalls = 0;
+   for (unsigned i = 0; i < SAT_TOT; ++i) nCalls += _nSat[i];
+   fprintf(stdout, "SAT calls: %u\n", nCalls);
+   for (unsigned i = 0; i < SAT_TOT; ++i) {
+      if (!_nSat[i]) continue;
+      fprintf(stdout, "   %-9s: %u call(s), %.3f s, conflicts %lld (avg %.1f, max %lld)\n",
+         resultStr[i], _nSat[i], _satTime[i], _nConflicts[i],
+         (double)_nConflicts[i] / _nSat[i], _maxConflicts[i]);
+   }
+
+   if (_nExpanded || _nExpandSkipped)
+      fprintf(stdout, "Expansion: %u counter-example(s), %u pattern(s) added, %u skipped (large cone), %.3f s\n",
+         _nExpanded, _nExpandPatterns, _nExpandSkipped, _expandTime);
+
+   unsigned nMerges = 0;
+   for (unsigned n : _vMerges) nMerges += n;
+   fprintf(stdout, "Merge rounds: %u, %u gate(s) merged", (unsigned)_vMerges.size(), nMerges);
+   if (!_vMerges.empty()) {
+      const unsigned maxShown = 16;
+      fprintf(stdout, " (");
+      for (unsigned i = 0, n = min((unsigned)_vMerges.size(), maxShown); i < n; ++i)
+         fprintf(stdout, "%s%u", (i ? " " : ""), _vMerges[i]);
+      if (_vMerges.size() > maxShown) fprintf(stdout, " ...");
+      fprintf(stdout, ")");
+   }
+   fprintf(stdout, "\n");
+   printSim();
+}
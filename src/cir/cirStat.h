@@ -0,0 +1,120 @@
+/****************************************************************************
+  FileName     [ cirStat.h ]
+  PackageName  [ cir ]
+  Synopsis     [ Phase counters of simulation and fraig ]
+  Author       [ agent ]
+  Date         [ 2026/10/18 created ]
+****************************************************************************/
+
+#ifndef CIRSTAT_H
+#define CIRSTAT_H
+
+#include <vector>
+#include <chrono>
+
+using namespace std;
+
+class CirStat;
+class CirStatTimer;
+
+// Counters of a CIRSIMulate or CIRFraig command.
+// Nothing is recorded unless enabled; the hooks are called per round or
+// per SAT call (never per gate), so a disabled CirStat costs one branch.
+class CirStat
+{
+public:
+   enum SatResult { SAT_SAT, SAT_UNSAT, SAT_UNDECIDED, SAT_TOT };
+
+   CirStat() : _bEnabled(false) { reset(); }
+
+   void setEnabled(const bool b) { _bEnabled = b; }
+   bool enabled() const { return _bEnabled; }
+
+   void reset() {
+      for (unsigned i = 0; i < SAT_TOT; ++i) {
+         _nSat[i] = _nConflicts[i] = _maxConflicts[i] = 0;
+         _satTime[i] = 0.0;
+      }
+      _nSimRounds = _nResimRounds = 0;
+      _calValueTime = _classifyTime = 0.0;
+      _vMerges.clear();
+      _nExpanded = _nExpandSkipped = _nExpandPatterns = 0;
+      _expandTime = 0.0;
+   }
+
+   // Hooks
+   void addSatCall(const SatResult r, const long long nConflicts, const double sec) {
+      if (!_bEnabled) return;
+      ++_nSat[r];
+      _nConflicts[r] += nConflicts;
+      if (nConflicts > _maxConflicts[r]) _maxConflicts[r] = nConflicts;
+      _satTime[r] += sec;
+   }
+   void addSimRound(const double calValueSec, const double classifySec) {
+      if (!_bEnabled) return;
+      ++_nSimRounds;
+      _calValueTime += calValueSec;
+      _classifyTime += classifySec;
+   }
+   void addResimRound() { if (_bEnabled) ++_nResimRounds; }
+   void addMergeRound(const unsigned nMerges) { if (_bEnabled) _vMerges.push_back(nMerges); }
+   void addExpansion(const bool bExpanded, const unsigned nPatterns, const double sec) {
+      if (!_bEnabled) return;
+      if (bExpanded) ++_nExpanded; else ++_nExpandSkipped;
+      _nExpandPatterns += nPatterns;
+      _expandTime += sec;
+   }
+
+   // Counters
+   unsigned nSatCalls(const SatResult r) const { return _nSat[r]; }
+   unsigned nMerges() const {
+      unsigned n = 0;
+      for (unsigned m : _vMerges) n += m;
+      return n;
+   }
+
+   // Reports
+   void printSim() const;
+   void printFraig() const;
+
+private:
+   bool              _bEnabled;
+
+   // SAT calls, by SatResult
+   unsigned          _nSat[SAT_TOT];
+   long long         _nConflicts[SAT_TOT];
+   long long         _maxConflicts[SAT_TOT];
+   double            _satTime[SAT_TOT];
+
+   // Simulation
+   unsigned          _nSimRounds;      // calls of sim_simulation()
+   unsigned          _nResimRounds;    // simulation of counter-examples in fraig
+   double            _calValueTime;
+   double            _classifyTime;
+
+   // Fraig
+   vector<unsigned>  _vMerges;         // number of merged gates of each merge round
+   unsigned          _nExpanded;       // counter-examples expanded (-Expand)
+   unsigned          _nExpandSkipped;  // counter-examples not expanded (cone too large)
+   unsigned          _nExpandPatterns; // neighbor patterns added
+   double            _expandTime;      // cone walks and pattern copies
+};
+
+// Measure the time of a scope only if 'bEnabled'
+class CirStatTimer
+{
+public:
+   CirStatTimer(const bool bEnabled) : _bEnabled(bEnabled) {
+      if (_bEnabled) _start = chrono::steady_clock::now();
+   }
+   double seconds() const {
+      if (!_bEnabled) return 0.0;
+      return chrono::duration<double>(chrono::steady_clock::now() - _start).count();
+   }
+
+private:
+   bool                                _bEnabled;
+   chrono::steady_clock::time_point    _start;
+};
+
+#endif // CIRSTAT_H
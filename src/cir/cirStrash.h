@@ -3,7 +3,8 @@
   PackageName  [ cir ]
   Synopsis     [ Classes for Strash command. 
                  CirStrashS is the key-value pair for HashSet implementation.
-                 CirStrashM is the key for HashMap implementation. ]
+                 CirStrashM is the key for HashMap implementation.
+                 CirStrashK is the key of a fanin pair (gate not built). ]
   Author       [ Chen-Hao Hsu ]
   Date         [ 2018/1/25 created ]
 ****************************************************************************/
@@ -12,6 +13,7 @@
 #define CIRSTRASH_H
 
 #include <iostream>
+#include "cirGate.h"
 
 using namespace std;
 
@@ -83,6 +85,43 @@ private:
    CirGate* _gate;
 };
 
+/******************************
+   Fanin-pair key
+******************************/
+// Used when the AND gate is not created yet (e.g. during reconstruction),
+// so the fanins are stored in the key itself.
+class CirStrashK
+{
+public:
+   CirStrashK(const CirGateV& f0 = CirGateV(), const CirGateV& f1 = CirGateV())
+      : _fanin0(f0), _fanin1(f1) {}
+   ~CirStrashK() {}
+
+   /* Key (Hash Function) */
+   size_t operator() () const {
+      return _fanin0 ^ _fanin1;
+   }
+
+   /* Key compare function */
+   bool operator == (const CirStrashK& c) const {
+      if (_fanin0 == c.fanin0())
+         return (_fanin1 == c.fanin1());
+      else if (_fanin0 == c.fanin1())
+         return (_fanin1 == c.fanin0());
+      else
+         return false;
+   }
+
+   /* Basic functions */
+   const CirGateV& fanin0() const { return _fanin0; }
+   const CirGateV& fanin1() const { return _fanin1; }
+   void setFanins(const CirGateV& f0, const CirGateV& f1) { _fanin0 = f0; _fanin1 = f1; }
+
+private:
+   CirGateV _fanin0;
+   CirGateV _fanin1;
+};
+
 #endif // CIRSTRASH_H
 
 
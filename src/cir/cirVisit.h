@@ -0,0 +1,62 @@
+/****************************************************************************
+  FileName     [ cirVisit.h ]
+  PackageName  [ cir ]
+  Synopsis     [ Define visit marks of gate traversals ]
+  Author       [ agent ]
+  Date         [ 2026/10/18 created ]
+****************************************************************************/
+
+#ifndef CIRVISIT_H
+#define CIRVISIT_H
+
+#include <vector>
+#include <algorithm>
+#include "cirGate.h"
+
+using namespace std;
+
+// Visit marks of a traversal, indexed by gate var.
+// A gate is visited iff its stamp equals the current epoch, so reset()
+// clears all marks in O(1) and a CirVisit can be reused by many traversals.
+// Stamps are 1 byte to keep the array cache-friendly; the array is cleared
+// once every 255 resets.
+// Marks are not stored in the gates: traversals with different CirVisit's
+// may run at the same time (e.g. in different threads), as long as they
+// do not modify the netlist. A CirVisit itself is not thread-safe.
+class CirVisit
+{
+   typedef unsigned char Stamp;
+
+public:
+   CirVisit(const size_t nGates = 0) : _epoch(1), _vStamp(nGates, 0) {}
+
+   // Start a new traversal; nGates is a hint, larger vars are still fine
+   void reset(const size_t nGates) {
+      if (_vStamp.size() < nGates) _vStamp.resize(nGates, 0);
+      if (++_epoch == 0) {   // wrapped around, stale stamps may match
+         fill(_vStamp.begin(), _vStamp.end(), 0);
+         _epoch = 1;
+      }
+   }
+
+   bool isVisited(const CirGate* g) const {
+      return g->var() < _vStamp.size() && _vStamp[g->var()] == _epoch;
+   }
+   void visit(const CirGate* g) {
+      if (g->var() >= _vStamp.size()) _vStamp.resize(g->var() + 1, 0);
+      _vStamp[g->var()] = _epoch;
+   }
+   // Mark g; return false if it was visited already
+   bool tryVisit(const CirGate* g) {
+      if (g->var() >= _vStamp.size()) _vStamp.resize(g->var() + 1, 0);
+      if (_vStamp[g->var()] == _epoch) return false;
+      _vStamp[g->var()] = _epoch;
+      return true;
+   }
+
+private:
+   Stamp              _epoch;
+   vector<Stamp>      _vStamp;
+};
+
+#endif // CIRVISIT_H
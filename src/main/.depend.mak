@@ -1,3 +1,5 @@
 main.o: main.cpp ../../include/util.h ../../include/rnGen.h \
- ../../include/myUsage.h ../../include/cmdParser.h \
- ../../include/cmdCharDef.h
+ ../../include/myUsage.h ../../include/myTrace.h \
+ ../../include/cmdParser.h ../../include/cmdCharDef.h \
+ ../../include/myProfiler.h
+server.o: server.cpp ../../include/cmdParser.h ../../include/cmdCharDef.h
@@ -6,8 +6,14 @@
   Copyright    [ Copyleft(c) 2007-present LaDs(III), GIEE, NTU, Taiwan ]
 ****************************************************************************/
 
+#include <sstream>
+#include <chrono>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/wait.h>
 #include "util.h"
 #include "cmdParser.h"
+#include "myProfiler.h"
 
 using namespace std;
 
@@ -18,11 +24,19 @@ CmdParser* cmdMgr = new CmdParser("fraig> ");
 
 extern bool initCommonCmd();
 extern bool initCirCmd();
+extern int  serverRun(const string& path, const double timeout);
+extern int  clientRun(const string& path, const vector<string>& vScript);
 
 static void
 usage()
 {
-   cout << "Usage: cirTest [ -File < doFile > ]" << endl;
+   cout << "Usage: cirTest [ -File < doFile > ] [ -Profile < csv/json File > ]"
+        << " [ -Trace < json File > ]\n"
+        << "       cirTest -Batch [ -File < doFile > ]... [ -Command < \"cmd; cmd...\" > ]...\n"
+        << "               [ -Jobs < num > ] [ -Log < dir > ] [ < circuit >... ]\n"
+        << "       cirTest -Server < socket > [ -TImeout < sec > ]\n"
+        << "       cirTest -CONnect < socket > [ -File < doFile > ]... [ -Command < \"cmd; cmd...\" > ]..."
+        << endl;
 }
 
 static void
@@ -32,38 +46,360 @@ myexit()
    exit(-1);
 }
 
+// The latest command line in history, e.g. "   3: cirsim -r" => (3, "cirsim -r").
+// Return false if there is no history.
+static bool
+lastCmd(int& idx, string& cmd)
+{
+   stringstream ss;
+   streambuf* oriBuf = cout.rdbuf(ss.rdbuf());
+   cmdMgr->printHistory(1);
+   cout.rdbuf(oriBuf);
+
+   string line;
+   if (!getline(ss, line)) return false;
+   const size_t begin = line.find_first_not_of(' ');
+   const size_t colon = line.find(':');
+   if (begin == string::npos || colon == string::npos || colon < begin ||
+       !myStr2Int(line.substr(begin, colon - begin), idx))
+      return false;
+   cmd = line.substr(min(colon + 2, line.size()));
+   return true;
+}
+
+// Nothing to do if no file is given
+static bool
+writeProfile(const MyProfiler& prof, const string& profFile)
+{
+   if (profFile.empty()) return true;
+   ofstream fout(profFile.c_str());
+   if (!fout) {
+      cerr << "Error: cannot open file \"" << profFile << "\"!!\n";
+      return false;
+   }
+   const bool bJson = profFile.size() >= 5 && profFile.substr(profFile.size() - 5) == ".json";
+   prof.write(fout, bJson);
+   return true;
+}
+
+//----------------------------------------------------------------------
+//    Batch mode
+//----------------------------------------------------------------------
+// Commands are executed directly by CmdExec::exec(), i.e. no line editor,
+// no terminal setup and no history. The first failing command stops the
+// run, and the exit code is 1.
+static MyProfiler batchProf;
+static bool       batchRecord = false;
+
+static bool
+batchReadFile(const string& fileName, vector<string>& vLines)
+{
+   if (fileName == "-") {
+      string line;
+      while (getline(cin, line)) vLines.push_back(line);
+      return true;
+   }
+   ifstream fin(fileName.c_str());
+   if (!fin) return false;
+   string line;
+   while (getline(fin, line)) vLines.push_back(line);
+   return true;
+}
+
+CmdExecStatus batchExec(const vector<string>& vLines, unsigned depth);
+
+static CmdExecStatus
+batchExecLine(string line, const unsigned depth)
+{
+   const size_t begin = line.find_first_not_of(" \t");
+   const size_t end = line.find_last_not_of(" \t\r");
+   if (begin == string::npos) return CMD_EXEC_NOP;
+   line = line.substr(begin, end - begin + 1);
+   string cmdStr;
+   size_t n = myStrGetTok(line, cmdStr);
+
+   cout << "fraig> " << line << endl;
+   CmdExec* e = cmdMgr->getCmd(cmdStr);
+   if (!e) {
+      cerr << "Illegal command!! (" << cmdStr << ")" << endl;
+      return CMD_EXEC_ERROR;
+   }
+   string option;
+   if (n != string::npos) {
+      n = line.find_first_not_of(' ', n);
+      if (n != string::npos) option = line.substr(n);
+   }
+
+   // QUIT asks for confirmation and DOfile pushes to the parser's stack;
+   // neither fits here
+   if (e == cmdMgr->getCmd("QUIT")) return CMD_EXEC_QUIT;
+   if (e == cmdMgr->getCmd("DOfile")) {
+      vector<string> vLines;
+      if (option.empty() || depth >= 1024 || !batchReadFile(option, vLines)) {
+         cerr << "Error: cannot open file \"" << option << "\"!!" << endl;
+         return CMD_EXEC_ERROR;
+      }
+      return batchExec(vLines, depth + 1);
+   }
+
+   double traceStart = 0;
+   if (batchRecord) {
+      batchProf.begin();
+      traceStart = myTrace.now();
+   }
+   const CmdExecStatus status = e->exec(option);
+   if (batchRecord) {
+      batchProf.end(line);
+      myTrace.complete(line, "cmd", traceStart);
+   }
+   cout << endl;
+   return status;
+}
+
+// Also used by the server (server.cpp)
+CmdExecStatus
+batchExec(const vector<string>& vLines, const unsigned depth)
+{
+   for (const string& line : vLines) {
+      const CmdExecStatus status = batchExecLine(line, depth);
+      if (status == CMD_EXEC_ERROR || status == CMD_EXEC_QUIT) return status;
+   }
+   return CMD_EXEC_DONE;
+}
+
+// Run the script once per circuit in up to nJobs child processes; the
+// output of job i (from 1, in the order of vCircuits) goes to
+// <logDir>/<i>_<circuit>.log, so circuits of the same name in different
+// directories do not share a log. Return #failed jobs.
+static unsigned
+batchRunJobs(const vector<string>& vScript, const vector<string>& vCircuits,
+             const unsigned nJobs, const string& logDir)
+{
+   typedef chrono::steady_clock Clock;
+   vector<pid_t> vPid(vCircuits.size(), 0);
+   vector<Clock::time_point> vStart(vCircuits.size());
+   unsigned nRunning = 0, nFailed = 0;
+   size_t next = 0;
+   const int idxWidth = (int)to_string(vCircuits.size()).size();
+   cout.flush();
+
+   while (next < vCircuits.size() || nRunning) {
+      if (next < vCircuits.size() && nRunning < nJobs) {
+         const string& cir = vCircuits[next];
+         const size_t slash = cir.find_last_of('/');
+         char idx[32];
+         snprintf(idx, sizeof(idx), "%0*u_", idxWidth, (unsigned)next + 1);
+         const string logFile = logDir + "/" + idx + cir.substr(slash == string::npos ? 0 : slash + 1) + ".log";
+         vStart[next] = Clock::now();
+         const pid_t pid = fork();
+         if (pid == 0) {
+            const int fd = open(logFile.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+            if (fd < 0) _exit(2);
+            dup2(fd, 1); dup2(fd, 2); close(fd);
+            CmdExecStatus status = batchExecLine("cirread " + cir, 0);
+            if (status != CMD_EXEC_ERROR) status = batchExec(vScript, 0);
+            // _exit(): the atexit handlers and static objects belong to the parent
+            cout.flush(); cerr.flush(); fflush(stdout); fflush(stderr);
+            _exit(status == CMD_EXEC_ERROR ? 1 : 0);
+         }
+         if (pid < 0) {
+            cerr << "Error: cannot fork for \"" << cir << "\"!!" << endl;
+            ++nFailed;
+         }
+         else { vPid[next] = pid; ++nRunning; }
+         ++next;
+         continue;
+      }
+
+      int wstatus;
+      const pid_t pid = wait(&wstatus);
+      if (pid < 0) break;
+      for (size_t i = 0; i < vPid.size(); ++i) {
+         if (vPid[i] != pid) continue;
+         const bool bOk = WIFEXITED(wstatus) && WEXITSTATUS(wstatus) == 0;
+         const double sec = chrono::duration<double>(Clock::now() - vStart[i]).count();
+         if (!bOk) ++nFailed;
+         fprintf(stdout, "%-6s %s (%.2f s)\n", (bOk ? "ok" : "FAIL"), vCircuits[i].c_str(), sec);
+         fflush(stdout);
+         --nRunning;
+         break;
+      }
+   }
+   fprintf(stdout, "%u job(s), %u failed\n", (unsigned)vCircuits.size(), nFailed);
+   return nFailed;
+}
+
 int
 main(int argc, char** argv)
 {
    myUsage.reset();
 
    ifstream dof;
+   string profFile;
+   bool bBatch = false;
+   vector<string> vDofiles, vCmds, vCircuits;
+   int nJobs = 1;
+   string logDir = ".";
+   string serverPath, connectPath;
+   int serverTimeout = 30;
 
-   if (argc == 3) {  // -file <doFile>
-      if (myStrNCmp("-File", argv[1], 2) == 0) {
-         if (!cmdMgr->openDofile(argv[2])) {
-            cerr << "Error: cannot open file \"" << argv[2] << "\"!!\n";
+   for (int i = 1; i < argc; ++i) {
+      if (myStrNCmp("-File", argv[i], 2) == 0) {  // -file <doFile>
+         if (++i == argc) {
+            cerr << "Error: missing argument after \"" << argv[i-1] << "\"!!\n";
             myexit();
          }
+         vDofiles.push_back(argv[i]);
+      }
+      else if (myStrNCmp("-Batch", argv[i], 2) == 0)  // -batch
+         bBatch = true;
+      else if (myStrNCmp("-Command", argv[i], 2) == 0) {  // -command <"cmd; cmd...">
+         if (++i == argc) {
+            cerr << "Error: missing argument after \"" << argv[i-1] << "\"!!\n";
+            myexit();
+         }
+         string cmds = argv[i];
+         for (size_t b = 0, e; b <= cmds.size(); b = e + 1) {
+            e = min(cmds.find(';', b), cmds.size());
+            vCmds.push_back(cmds.substr(b, e - b));
+         }
+         bBatch = true;
+      }
+      else if (myStrNCmp("-Jobs", argv[i], 2) == 0) {  // -jobs <num>
+         if (++i == argc) {
+            cerr << "Error: missing argument after \"" << argv[i-1] << "\"!!\n";
+            myexit();
+         }
+         if (!myStr2Int(argv[i], nJobs) || nJobs <= 0) {
+            cerr << "Error: illegal number of jobs \"" << argv[i] << "\"!!\n";
+            myexit();
+         }
+         bBatch = true;
+      }
+      else if (myStrNCmp("-Server", argv[i], 2) == 0) {  // -server <socket>
+         if (++i == argc) {
+            cerr << "Error: missing argument after \"" << argv[i-1] << "\"!!\n";
+            myexit();
+         }
+         serverPath = argv[i];
+      }
+      else if (myStrNCmp("-TImeout", argv[i], 3) == 0) {  // -timeout <sec>
+         if (++i == argc) {
+            cerr << "Error: missing argument after \"" << argv[i-1] << "\"!!\n";
+            myexit();
+         }
+         if (!myStr2Int(argv[i], serverTimeout) || serverTimeout <= 0) {
+            cerr << "Error: illegal timeout \"" << argv[i] << "\"!!\n";
+            myexit();
+         }
+      }
+      else if (myStrNCmp("-CONnect", argv[i], 4) == 0) {  // -connect <socket>
+         if (++i == argc) {
+            cerr << "Error: missing argument after \"" << argv[i-1] << "\"!!\n";
+            myexit();
+         }
+         connectPath = argv[i];
+      }
+      else if (myStrNCmp("-Log", argv[i], 2) == 0) {  // -log <dir>
+         if (++i == argc) {
+            cerr << "Error: missing argument after \"" << argv[i-1] << "\"!!\n";
+            myexit();
+         }
+         logDir = argv[i];
+      }
+      else if (myStrNCmp("-Profile", argv[i], 2) == 0) {  // -profile <csv/json File>
+         if (++i == argc) {
+            cerr << "Error: missing argument after \"" << argv[i-1] << "\"!!\n";
+            myexit();
+         }
+         profFile = argv[i];
+      }
+      else if (myStrNCmp("-Trace", argv[i], 2) == 0) {  // -trace <json File>
+         if (++i == argc) {
+            cerr << "Error: missing argument after \"" << argv[i-1] << "\"!!\n";
+            myexit();
+         }
+         if (!myTrace.open(argv[i])) {
+            cerr << "Error: cannot open file \"" << argv[i] << "\"!!\n";
+            myexit();
+         }
+      }
+      else if (argv[i][0] != '-') {  // circuit of batch jobs
+         vCircuits.push_back(argv[i]);
+         bBatch = true;
       }
       else {
-         cerr << "Error: unknown argument \"" << argv[1] << "\"!!\n";
+         cerr << "Error: unknown argument \"" << argv[i] << "\"!!\n";
          myexit();
       }
    }
-   else if (argc != 1) {
-      cerr << "Error: illegal number of argument (" << argc << ")!!\n";
-      myexit();
-   }
 
    if (!initCommonCmd() || !initCirCmd())
       return 1;
 
+   if (!serverPath.empty())
+      return serverRun(serverPath, serverTimeout);
+
+   if (bBatch || !connectPath.empty()) {
+      // Script = do files, then -Command; stdin if neither is given
+      vector<string> vScript;
+      if (vDofiles.empty() && vCmds.empty()) vDofiles.push_back("-");
+      for (const string& f : vDofiles) {
+         if (!batchReadFile(f, vScript)) {
+            cerr << "Error: cannot open file \"" << f << "\"!!\n";
+            myexit();
+         }
+      }
+      vScript.insert(vScript.end(), vCmds.begin(), vCmds.end());
+      if (!connectPath.empty())
+         return clientRun(connectPath, vScript);
+
+      if (!vCircuits.empty()) {
+         if (!profFile.empty() || myTrace.isOpen()) {
+            cerr << "Error: -Profile and -Trace are not supported with batch jobs!!\n";
+            myexit();
+         }
+         return batchRunJobs(vScript, vCircuits, nJobs, logDir) ? 1 : 0;
+      }
+
+      batchRecord = !profFile.empty() || myTrace.isOpen();
+      const CmdExecStatus status = batchExec(vScript, 0);
+      myTrace.close();
+      if (!writeProfile(batchProf, profFile)) return 1;
+      return status == CMD_EXEC_ERROR ? 1 : 0;
+   }
+
+   if (vDofiles.size() > 1) {
+      cerr << "Error: only one do file is allowed without -Batch!!\n";
+      myexit();
+   }
+   if (!vDofiles.empty() && !cmdMgr->openDofile(vDofiles[0])) {
+      cerr << "Error: cannot open file \"" << vDofiles[0] << "\"!!\n";
+      myexit();
+   }
+
+   MyProfiler prof;
+   const bool doRecord = !profFile.empty() || myTrace.isOpen();
+   int lastIdx = -1, idx;
+   string cmd;
+   double traceStart = 0;
+
    CmdExecStatus status = CMD_EXEC_DONE;
    while (status != CMD_EXEC_QUIT) {  // until "quit" or command error
+      if (doRecord) {
+         prof.begin();
+         if (myTrace.isOpen()) traceStart = myTrace.now();
+      }
       status = cmdMgr->execOneCmd();
+      // An empty line does not enter the history
+      if (doRecord && lastCmd(idx, cmd) && idx != lastIdx) {
+         prof.end(cmd);
+         myTrace.complete(cmd, "cmd", traceStart);
+         lastIdx = idx;
+      }
       cout << endl;  // a blank line between each command
    }
+   myTrace.close();
 
-   return 0;
+   return writeProfile(prof, profFile) ? 0 : 1;
 }
@@ -0,0 +1,325 @@
+/****************************************************************************
+  FileName     [ server.cpp ]
+  PackageName  [ main ]
+  Synopsis     [ Serve command scripts over a Unix domain socket ]
+  Author       [ agent ]
+  Date         [ 2026/10/18 created ]
+****************************************************************************/
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cerrno>
+#include <csignal>
+#include <chrono>
+#include <iostream>
+#include <vector>
+#include <string>
+#include <unistd.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/stat.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include "cmdParser.h"
+
+using namespace std;
+
+// Protocol: a client connects, sends a command script and shuts down its
+// write side. The output of the commands is streamed back, followed by
+// the line "%%EXIT <code>" (0: all commands done, 1: a command failed,
+// 2: timed out), then the connection is closed. The circuits (see
+// CIRSElect) stay resident between sessions.
+//
+// The scripts of all connected clients are received at the same time, so
+// a slow client does not hold up the others. The scripts are then run one
+// at a time in the order they are complete, since the commands share the
+// circuits and the process-wide stdout. Limits (see -TImeout):
+//    - a client that sends nothing for the timeout is dropped with exit 2
+//    - a client that does not read its output for the timeout loses the
+//      rest of it; the script still runs to the end
+//    - a long script delays the scripts behind it
+
+extern CmdExecStatus batchExec(const vector<string>& vLines, unsigned depth);
+
+/**************************************/
+/*   Static varaibles and functions   */
+/**************************************/
+static const char* exitTag = "%%EXIT ";
+
+static volatile sig_atomic_t serverStop = 0;
+
+// A connected client whose script is being received
+struct ServerClient
+{
+   int                              fd;
+   string                           script;
+   chrono::steady_clock::time_point start;    // accepted
+   chrono::steady_clock::time_point last;     // last data received
+};
+
+static void
+serverSignal(int)
+{
+   serverStop = 1;
+}
+
+static bool
+socketAddr(const string& path, sockaddr_un& addr)
+{
+   memset(&addr, 0, sizeof(addr));
+   addr.sun_family = AF_UNIX;
+   if (path.empty() || path.size() >= sizeof(addr.sun_path)) {
+      cerr << "Error: illegal socket path \"" << path << "\"!!" << endl;
+      return false;
+   }
+   strcpy(addr.sun_path, path.c_str());
+   return true;
+}
+
+static bool
+writeAll(const int fd, const char* buf, size_t n)
+{
+   while (n) {
+      const ssize_t k = write(fd, buf, n);
+      if (k < 0 && errno == EINTR) continue;
+      if (k <= 0) return false;
+      buf += k;
+      n -= k;
+   }
+   return true;
+}
+
+static void
+setSendTimeout(const int fd, const double seconds)
+{
+   timeval tv;
+   tv.tv_sec = (time_t)seconds;
+   tv.tv_usec = (suseconds_t)((seconds - tv.tv_sec) * 1e6);
+   setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
+}
+
+// Run the received script with stdout and stderr redirected to the client
+static void
+serverSession(const ServerClient& c, const unsigned id, const double timeout)
+{
+   vector<string> vLines;
+   for (size_t b = 0, e; b < c.script.size(); b = e + 1) {
+      e = min(c.script.find('\n', b), c.script.size());
+      vLines.push_back(c.script.substr(b, e - b));
+   }
+
+   // A client that stops reading makes the writes fail after the timeout,
+   // rather than blocking the server
+   setSendTimeout(c.fd, timeout);
+   cout.flush(); fflush(stdout); fflush(stderr);
+   const int oriOut = dup(1), oriErr = dup(2);
+   dup2(c.fd, 1); dup2(c.fd, 2);
+   const CmdExecStatus status = batchExec(vLines, 0);
+   cout.flush(); cerr.flush(); fflush(stdout); fflush(stderr);
+   dup2(oriOut, 1); dup2(oriErr, 2);
+   close(oriOut); close(oriErr);
+   cout.clear(); cerr.clear(); clearerr(stdout); clearerr(stderr);
+
+   const int code = status == CMD_EXEC_ERROR ? 1 : 0;
+   const string trailer = exitTag + to_string(code) + "\n";
+   writeAll(c.fd, trailer.data(), trailer.size());
+
+   const double sec = chrono::duration<double>(chrono::steady_clock::now() - c.start).count();
+   fprintf(stdout, "Session %u: %u line(s), exit %d (%.3f s)\n", id, (unsigned)vLines.size(), code, sec);
+   fflush(stdout);
+}
+
+// Drop a client that sent nothing for the timeout
+static void
+serverTimeout(const ServerClient& c, const unsigned id, const double timeout)
+{
+   char msg[128];
+   snprintf(msg, sizeof(msg), "Error: no script received in %g s!!\n%s2\n", timeout, exitTag);
+   setSendTimeout(c.fd, timeout);
+   writeAll(c.fd, msg, strlen(msg));
+   fprintf(stdout, "Session %u: timed out\n", id);
+   fflush(stdout);
+}
+
+// Return true if a server is accepting connections on addr
+static bool
+serverAlive(const sockaddr_un& addr)
+{
+   const int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+   if (fd < 0) return false;
+   const bool bAlive = connect(fd, (sockaddr*)&addr, sizeof(addr)) == 0;
+   close(fd);
+   return bAlive;
+}
+
+/**************************************/
+/*   Server and client                */
+/**************************************/
+// Serve until SIGINT or SIGTERM; return the exit code of the program.
+// See the protocol above for 'timeout' (in seconds).
+int
+serverRun(const string& path, const double timeout)
+{
+   sockaddr_un addr;
+   if (!socketAddr(path, addr)) return 1;
+   const int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+   if (fd < 0) {
+      cerr << "Error: cannot create socket (" << strerror(errno) << ")!!" << endl;
+      return 1;
+   }
+   // Remove a stale socket of a previous server, but never another file
+   // or the socket of a running server
+   struct stat st;
+   if (lstat(path.c_str(), &st) == 0) {
+      if (!S_ISSOCK(st.st_mode)) {
+         cerr << "Error: \"" << path << "\" exists and is not a socket!!" << endl;
+         close(fd);
+         return 1;
+      }
+      if (serverAlive(addr)) {
+         cerr << "Error: a server is already running on \"" << path << "\"!!" << endl;
+         close(fd);
+         return 1;
+      }
+      unlink(path.c_str());
+   }
+   if (bind(fd, (sockaddr*)&addr, sizeof(addr)) < 0 || listen(fd, 64) < 0) {
+      cerr << "Error: cannot listen on \"" << path << "\" (" << strerror(errno) << ")!!" << endl;
+      close(fd);
+      return 1;
+   }
+
+   // No SA_RESTART: a signal interrupts poll()
+   struct sigaction sa;
+   memset(&sa, 0, sizeof(sa));
+   sa.sa_handler = serverSignal;
+   sigaction(SIGINT, &sa, 0);
+   sigaction(SIGTERM, &sa, 0);
+   signal(SIGPIPE, SIG_IGN);   // a client may leave early
+
+   fprintf(stdout, "Listening on \"%s\"...\n", path.c_str());
+   fflush(stdout);
+   fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+   unsigned nSessions = 0;
+   vector<ServerClient> vClients;
+   vector<pollfd> vPoll;
+   char buf[65536];
+   while (!serverStop) {
+      // Wait for a new client, data, or the earliest timeout
+      const auto now = chrono::steady_clock::now();
+      int waitMs = -1;
+      vPoll.assign(1, pollfd{ fd, POLLIN, 0 });
+      for (const ServerClient& c : vClients) {
+         vPoll.push_back(pollfd{ c.fd, POLLIN, 0 });
+         const double left = timeout - chrono::duration<double>(now - c.last).count();
+         const int ms = left > 0 ? (int)(left * 1000) + 1 : 0;
+         if (waitMs < 0 || ms < waitMs) waitMs = ms;
+      }
+      if (poll(vPoll.data(), vPoll.size(), waitMs) < 0) {
+         if (errno == EINTR) continue;
+         cerr << "Error: poll fails (" << strerror(errno) << ")!!" << endl;
+         break;
+      }
+
+      // Receive; a script is complete when the client shuts down its write side
+      vector<ServerClient> vReady;
+      for (size_t i = vClients.size(); i-- > 0; ) {
+         ServerClient& c = vClients[i];
+         bool bDone = false, bDrop = false;
+         if (vPoll[i + 1].revents) {
+            const ssize_t n = read(c.fd, buf, sizeof(buf));
+            if (n > 0) {
+               c.script.append(buf, n);
+               c.last = chrono::steady_clock::now();
+            }
+            else if (n == 0) bDone = true;
+            else if (errno != EINTR && errno != EAGAIN) bDrop = true;
+         }
+         if (!bDone && !bDrop &&
+             chrono::duration<double>(chrono::steady_clock::now() - c.last).count() >= timeout) {
+            serverTimeout(c, ++nSessions, timeout);
+            bDrop = true;
+         }
+         if (bDone) vReady.push_back(c);
+         else if (bDrop) close(c.fd);
+         if (bDone || bDrop) vClients.erase(vClients.begin() + i);
+      }
+      // An empty script (e.g. the probe of serverAlive()) is not a session
+      for (auto it = vReady.rbegin(); it != vReady.rend(); ++it) {
+         if (it->script.empty()) {
+            const string trailer = exitTag + string("0\n");
+            writeAll(it->fd, trailer.data(), trailer.size());
+         }
+         else serverSession(*it, ++nSessions, timeout);
+         close(it->fd);
+      }
+
+      if (vPoll[0].revents) {
+         int cfd;
+         while ((cfd = accept(fd, 0, 0)) >= 0) {
+            const auto t = chrono::steady_clock::now();
+            vClients.push_back(ServerClient{ cfd, string(), t, t });
+         }
+         if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR && errno != ECONNABORTED) {
+            cerr << "Error: accept fails (" << strerror(errno) << ")!!" << endl;
+            break;
+         }
+      }
+   }
+   for (const ServerClient& c : vClients) close(c.fd);
+   close(fd);
+   unlink(path.c_str());
+   fprintf(stdout, "Server stopped after %u session(s).\n", nSessions);
+   return 0;
+}
+
+// Send the script and print the output; return the exit code of the
+// script, or 2 if the connection fails
+int
+clientRun(const string& path, const vector<string>& vScript)
+{
+   sockaddr_un addr;
+   if (!socketAddr(path, addr)) return 2;
+   const int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+   if (fd < 0 || connect(fd, (sockaddr*)&addr, sizeof(addr)) < 0) {
+      cerr << "Error: cannot connect to \"" << path << "\" (" << strerror(errno) << ")!!" << endl;
+      if (fd >= 0) close(fd);
+      return 2;
+   }
+   string script;
+   for (const string& line : vScript) script += line + "\n";
+   if (!writeAll(fd, script.data(), script.size())) {
+      cerr << "Error: cannot send the script!!" << endl;
+      close(fd);
+      return 2;
+   }
+   shutdown(fd, SHUT_WR);
+
+   // Hold back the last line, which may be the trailer
+   string pending;
+   char buf[65536];
+   ssize_t n;
+   while ((n = read(fd, buf, sizeof(buf))) != 0) {
+      if (n < 0 && errno == EINTR) continue;
+      if (n < 0) break;
+      pending.append(buf, n);
+      if (pending.size() < 2) continue;
+      const size_t last = pending.find_last_of('\n', pending.size() - 2);
+      if (last == string::npos) continue;
+      fwrite(pending.data(), 1, last + 1, stdout);
+      fflush(stdout);
+      pending.erase(0, last + 1);
+   }
+   close(fd);
+
+   const size_t tag = pending.rfind(exitTag);
+   if (tag == string::npos || (tag > 0 && pending[tag - 1] != '\n')) {
+      fwrite(pending.data(), 1, pending.size(), stdout);
+      cerr << "Error: connection closed unexpectedly!!" << endl;
+      return 2;
+   }
+   fwrite(pending.data(), 1, tag, stdout);
+   return atoi(pending.c_str() + tag + strlen(exitTag));
+}
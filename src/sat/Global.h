@@ -27,6 +27,7 @@ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWA
 #include <climits>
 #include <cfloat>
 #include <new>
+#include <chrono>
 
 
 //=================================================================================================
@@ -101,6 +102,10 @@ static inline int irand(double& seed, int size) {
 // Time and Memory:
 
 
+// Monotonic wall-clock seconds; only differences are meaningful (e.g. deadlines).
+static inline double wallTime(void) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count(); }
+
 //- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 #ifdef _MSC_VER
 
@@ -684,6 +684,12 @@ lbool Solver::search(int nof_conflicts, int nof_learnts, const SearchParams& par
                 cancelUntil(root_level);
                 return l_Undef; }
 
+            if (time_budget_end >= 0 && (stats.decisions & 1023) == 0 && wallTime() >= time_budget_end){
+                // Reached the time budget (checked every 1024 decisions):
+                budget_out = true;
+                cancelUntil(root_level);
+                return l_Undef; }
+
             if (decisionLevel() == 0)
                 // Simplify the set of problem clauses:
                 simplifyDB(), assert(ok);
@@ -758,6 +764,7 @@ void Solver::claRescaleActivity()
 |________________________________________________________________________________________________@*/
 bool Solver::solve(const vec<Lit>& assumps)
 {
+    budget_out = false;
     simplifyDB();
     if (!ok) return false;
 
@@ -803,7 +810,12 @@ bool Solver::solve(const vec<Lit>& assumps)
         reportf("===================================\n");
     }
 
+    const int64 budget_end = stats.conflicts + conflict_budget;
     while (status == l_Undef){
+        if (budget_out || (conflict_budget >= 0 && stats.conflicts >= budget_end) ||
+            (time_budget_end >= 0 && wallTime() >= time_budget_end)){
+            budget_out = true;
+            break; }
         if (verbosity >= 1){
             printStats();
             reportf("| %9d | %7d %8d | %7d %7d %8d %7.1f | %6.3f %% |\n",
@@ -815,7 +827,10 @@ bool Solver::solve(const vec<Lit>& assumps)
                    progress_estimate*100);
             fflush(stdout);
         }
-        status = search((int)nof_conflicts, (int)nof_learnts, params);
+        int restart_conflicts = (int)nof_conflicts;
+        if (conflict_budget >= 0 && budget_end - stats.conflicts < restart_conflicts)
+            restart_conflicts = (int)(budget_end - stats.conflicts);
+        status = search(restart_conflicts, (int)nof_learnts, params);
         nof_conflicts *= 1.5;
         nof_learnts   *= 1.1;
 
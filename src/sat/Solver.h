@@ -136,6 +136,9 @@ public:
              , expensive_ccmin  (2)
              , proof            (NULL)
              , verbosity        (0)
+             , conflict_budget  (-1)
+             , time_budget_end  (-1)
+             , budget_out       (false)
              , progress_estimate(0)
              , conflict_id      (ClauseId_NULL)
              {
@@ -175,6 +178,9 @@ public:
     int             expensive_ccmin;    // Controls conflict clause minimization. TRUE by default.
     Proof*          proof;              // Set this directly after constructing 'Solver' to enable proof logging. Initialized to NULL.
     int             verbosity;          // Verbosity level. 0=silent, 1=some progress report, 2=everything
+    int64           conflict_budget;    // Max. number of conflicts of one 'solve()'; negative means no limit.
+    double          time_budget_end;    // 'wallTime()' at which 'solve()' gives up; negative means no limit.
+    bool            budget_out;         // Set by 'solve()': it stopped at a budget (result unknown, returns FALSE).
 
     // Problem specification:
     //
@@ -19,7 +19,7 @@ using namespace std;
 class SatSolver
 {
    public : 
-      SatSolver():_solver(0) { }
+      SatSolver():_solver(0), _budget(-1), _deadline(-1) { }
       ~SatSolver() { }
 
       // Solver initialization and reset
@@ -30,6 +30,8 @@ class SatSolver
       void reset() {
          if (_solver) delete _solver;
          _solver = new Solver();
+         _solver->conflict_budget = _budget;
+         _solver->time_budget_end = _deadline;
          _assump.clear(); _curVar = 0;
       }
 
@@ -77,6 +79,24 @@ class SatSolver
          _assump.push(val? Lit(prop): ~Lit(prop));
       }
       bool assumpSolve() { return _solver->solve(_assump); }
+      // Max. number of conflicts of each solve; negative means no limit.
+      // With a budget, use "assumpSolveLimited()": an undecided
+      // "assumpSolve()" returns false, as if it was UNSAT.
+      void setConflictBudget(int64 n) {
+         _budget = n;
+         if (_solver) _solver->conflict_budget = n;
+      }
+      // 'wallTime()' after which each solve gives up (undecided);
+      // negative means no limit.
+      void setDeadline(double t) {
+         _deadline = t;
+         if (_solver) _solver->time_budget_end = t;
+      }
+      // Return 1/0/-1 (SAT/UNSAT/undecided)
+      int assumpSolveLimited() {
+         const bool sat = _solver->solve(_assump);
+         return _solver->budget_out ? -1 : (sat ? 1 : 0);
+      }
 
       // For one time proof, use "solve"
       void assertProperty(Var prop, bool val) {
@@ -90,11 +110,14 @@ class SatSolver
          return (_solver->modelValue(v)==l_True?1:
                 (_solver->modelValue(v)==l_False?0:-1)); }
       void printStats() const { const_cast<Solver*>(_solver)->printStats(); }
+      int64 nConflicts() const { return _solver->stats.conflicts; }
 
    private : 
       Solver           *_solver;    // Pointer to a Minisat solver
       Var               _curVar;    // Variable currently
       vec<Lit>          _assump;    // Assumption List for assumption solve
+      int64             _budget;    // Conflict budget of each solve
+      double            _deadline;  // Wall time limit of each solve
 };
 
 #endif  // SAT_H
@@ -1,3 +1,4 @@
-myString.o: myString.cpp
 myGetChar.o: myGetChar.cpp
-util.o: util.cpp rnGen.h myUsage.h
+myString.o: myString.cpp
+myTrace.o: myTrace.cpp myTrace.h
+util.o: util.cpp rnGen.h myUsage.h myTrace.h
@@ -1,4 +1,4 @@
-util.d: ../../include/util.h ../../include/rnGen.h ../../include/myUsage.h ../../include/myHashMap.h ../../include/myHashSet.h 
+util.d: ../../include/util.h ../../include/rnGen.h ../../include/myUsage.h ../../include/myProfiler.h ../../include/myTrace.h ../../include/myHashMap.h ../../include/myHashSet.h 
 ../../include/util.h: util.h
 	@rm -f ../../include/util.h
 	@ln -fs ../src/util/util.h ../../include/util.h
@@ -8,6 +8,12 @@ util.d: ../../include/util.h ../../include/rnGen.h ../../include/myUsage.h ../..
 ../../include/myUsage.h: myUsage.h
 	@rm -f ../../include/myUsage.h
 	@ln -fs ../src/util/myUsage.h ../../include/myUsage.h
+../../include/myProfiler.h: myProfiler.h
+	@rm -f ../../include/myProfiler.h
+	@ln -fs ../src/util/myProfiler.h ../../include/myProfiler.h
+../../include/myTrace.h: myTrace.h
+	@rm -f ../../include/myTrace.h
+	@ln -fs ../src/util/myTrace.h ../../include/myTrace.h
 ../../include/myHashMap.h: myHashMap.h
 	@rm -f ../../include/myHashMap.h
 	@ln -fs ../src/util/myHashMap.h ../../include/myHashMap.h
@@ -0,0 +1,127 @@
+/****************************************************************************
+  FileName     [ myProfiler.h ]
+  PackageName  [ util ]
+  Synopsis     [ Record the run time and memory usage of each command ]
+  Author       [ agent ]
+  Date         [ 2026/10/18 created ]
+****************************************************************************/
+
+#ifndef MY_PROFILER_H
+#define MY_PROFILER_H
+
+#include <unistd.h>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <sys/resource.h>
+
+using namespace std;
+
+// Usage:
+//    prof.begin();
+//    ... execute a command ...
+//    prof.end(cmdLine);
+//    prof.write(os, bJson);   // at exit
+//
+// For each command, record
+//    wall time, CPU time (user + system),
+//    current RSS (/proc/self/statm) and the increase of peak RSS (ru_maxrss)
+class MyProfiler
+{
+public:
+   struct Record {
+      string   cmd;
+      double   wall;       // seconds
+      double   cpu;        // seconds
+      double   rss;        // MB
+      double   peakDelta;  // MB
+   };
+
+   MyProfiler() : _cpu(0), _peak(0) {}
+
+   void begin() {
+      _start = chrono::steady_clock::now();
+      _cpu = checkCpu();
+      _peak = checkPeak();
+   }
+   void end(const string& cmd) {
+      Record r;
+      r.cmd = cmd;
+      r.wall = chrono::duration<double>(chrono::steady_clock::now() - _start).count();
+      r.cpu = checkCpu() - _cpu;
+      r.rss = checkRss();
+      r.peakDelta = checkPeak() - _peak;
+      _records.push_back(r);
+   }
+
+   const vector<Record>& records() const { return _records; }
+
+   void write(ostream& os, bool bJson) const {
+      os << fixed << setprecision(6);
+      if (bJson) {
+         os << "[" << endl;
+         for (size_t i = 0, n = _records.size(); i < n; ++i) {
+            const Record& r = _records[i];
+            os << "  {\"cmd\": \"" << escape(r.cmd, true) << "\", \"wall\": " << r.wall
+               << ", \"cpu\": " << r.cpu << ", \"rss_mb\": " << r.rss
+               << ", \"peak_delta_mb\": " << r.peakDelta << "}"
+               << (i + 1 < n ? "," : "") << endl;
+         }
+         os << "]" << endl;
+      }
+      else {
+         os << "cmd,wall,cpu,rss_mb,peak_delta_mb" << endl;
+         for (const Record& r : _records)
+            os << "\"" << escape(r.cmd, false) << "\"," << r.wall << "," << r.cpu << ","
+               << r.rss << "," << r.peakDelta << endl;
+      }
+      os.unsetf(ios::floatfield);
+   }
+
+private:
+   chrono::steady_clock::time_point _start;
+   double            _cpu;
+   double            _peak;
+   vector<Record>    _records;
+
+   // private functions
+   double checkCpu() const {
+      struct rusage usage;
+      if (0 != getrusage(RUSAGE_SELF, &usage)) return 0;
+      return usage.ru_utime.tv_sec + usage.ru_utime.tv_usec / 1e6
+           + usage.ru_stime.tv_sec + usage.ru_stime.tv_usec / 1e6;
+   }
+   double checkPeak() const {  // in MB
+      struct rusage usage;
+      if (0 != getrusage(RUSAGE_SELF, &usage)) return 0;
+#ifdef __APPLE__
+      return usage.ru_maxrss/double(1<<20); // bytes
+#else
+      return usage.ru_maxrss/double(1<<10); // KBytes
+#endif
+   }
+   double checkRss() const {   // in MB
+      FILE* f = fopen("/proc/self/statm", "r");
+      if (!f) return 0;
+      long size = 0, resident = 0;
+      const int n = fscanf(f, "%ld %ld", &size, &resident);
+      fclose(f);
+      if (n != 2) return 0;
+      return resident * (double)sysconf(_SC_PAGESIZE) / double(1<<20);
+   }
+   // CSV: double the quotes; JSON: escape quotes and backslashes
+   static string escape(const string& s, bool bJson) {
+      string res;
+      for (char c : s) {
+         if (c == '"') res += (bJson ? "\\\"" : "\"\"");
+         else if (c == '\\' && bJson) res += "\\\\";
+         else res += c;
+      }
+      return res;
+   }
+};
+
+#endif // MY_PROFILER_H
@@ -0,0 +1,85 @@
+/****************************************************************************
+  FileName     [ myTrace.cpp ]
+  PackageName  [ util ]
+  Synopsis     [ Define the trace-event sink ]
+  Author       [ agent ]
+  Date         [ 2026/10/18 created ]
+****************************************************************************/
+
+#include <cstdio>
+#include "myTrace.h"
+
+using namespace std;
+
+/**************************************/
+/*   Static varaibles and functions   */
+/**************************************/
+static string
+jsonEscape(const string& s)
+{
+   string res;
+   for (char c : s) {
+      if (c == '"' || c == '\\') { res += '\\'; res += c; }
+      else if ((unsigned char)c < 0x20) {
+         char buf[8];
+         snprintf(buf, sizeof(buf), "\\u%04x", c);
+         res += buf;
+      }
+      else res += c;
+   }
+   return res;
+}
+
+/*******************************/
+/*   class MyTrace functions   */
+/*******************************/
+bool
+MyTrace::open(const string& fileName)
+{
+   close();
+   _ofs.open(fileName.c_str());
+   if (!_ofs) return false;
+   _bFirst = true;
+   _start = chrono::steady_clock::now();
+   _ofs << "{\"traceEvents\": [";
+   return true;
+}
+
+void
+MyTrace::close()
+{
+   if (!isOpen()) return;
+   _ofs << "\n]}" << endl;
+   _ofs.close();
+}
+
+void
+MyTrace::complete(const string& name, const char* cat, const double startUs, const string& args)
+{
+   if (!isOpen()) return;
+   char buf[128];
+   snprintf(buf, sizeof(buf), "\"ts\": %.3f, \"dur\": %.3f", startUs, now() - startUs);
+   writeSep();
+   _ofs << "{\"name\": \"" << jsonEscape(name) << "\", \"cat\": \"" << cat
+        << "\", \"ph\": \"X\", " << buf << ", \"pid\": 1, \"tid\": 1";
+   if (!args.empty()) _ofs << ", \"args\": {" << args << "}";
+   _ofs << "}";
+}
+
+void
+MyTrace::counter(const char* name, const char* key, const double value)
+{
+   if (!isOpen()) return;
+   char buf[64];
+   snprintf(buf, sizeof(buf), "\"ts\": %.3f", now());
+   writeSep();
+   _ofs << "{\"name\": \"" << name << "\", \"ph\": \"C\", " << buf
+        << ", \"pid\": 1, \"args\": {\"" << key << "\": " << value << "}}";
+}
+
+void
+MyTrace::writeSep()
+{
+   _ofs << (_bFirst ? "\n" : ",\n");
+   _bFirst = false;
+}
@@ -0,0 +1,85 @@
+/****************************************************************************
+  FileName     [ myTrace.h ]
+  PackageName  [ util ]
+  Synopsis     [ Record scoped events in Chrome trace-event format ]
+  Author       [ agent ]
+  Date         [ 2026/10/18 created ]
+****************************************************************************/
+
+#ifndef MY_TRACE_H
+#define MY_TRACE_H
+
+#include <string>
+#include <chrono>
+#include <fstream>
+
+using namespace std;
+
+class MyTrace;
+class MyTraceScope;
+
+// Trace sink; events are written to the file as they complete, so a
+// long session can be inspected even if the program is killed.
+// Load the file in chrome://tracing or Perfetto.
+// Not thread-safe: record events in the main thread only.
+class MyTrace
+{
+public:
+   MyTrace() : _bFirst(true) {}
+   ~MyTrace() { close(); }
+
+   bool open(const string& fileName);
+   void close();
+   bool isOpen() const { return _ofs.is_open(); }
+
+   // Microseconds since open()
+   double now() const {
+      return chrono::duration<double, micro>(chrono::steady_clock::now() - _start).count();
+   }
+
+   // Complete event ("X") of [startUs, now()]; 'args' is a JSON object body,
+   // e.g. "\"n\": 3"
+   void complete(const string& name, const char* cat, const double startUs,
+                 const string& args = "");
+   // Counter event ("C"), drawn as a graph
+   void counter(const char* name, const char* key, const double value);
+
+private:
+   ofstream                            _ofs;
+   bool                                _bFirst;
+   chrono::steady_clock::time_point    _start;
+
+   void writeSep();
+};
+
+// Defined in util.cpp
+extern MyTrace myTrace;
+
+// Record the scope as one event. If the trace is closed, only one branch
+// is paid here and in the destructor.
+class MyTraceScope
+{
+public:
+   MyTraceScope(const char* name, const char* cat)
+      : _name(name), _cat(cat), _bOn(myTrace.isOpen()), _start(0) {
+      if (_bOn) _start = myTrace.now();
+   }
+   ~MyTraceScope() {
+      if (_bOn) myTrace.complete(_name, _cat, _start, _args);
+   }
+
+   void arg(const char* key, const long long value) {
+      if (!_bOn) return;
+      if (!_args.empty()) _args += ", ";
+      _args += string("\"") + key + "\": " + to_string(value);
+   }
+
+private:
+   const char*    _name;
+   const char*    _cat;
+   bool           _bOn;
+   double         _start;
+   string         _args;
+};
+
+#endif // MY_TRACE_H
@@ -16,6 +16,7 @@
 #include <algorithm>
 #include "rnGen.h"
 #include "myUsage.h"
+#include "myTrace.h"
 
 using namespace std;
 
@@ -25,6 +26,7 @@ using namespace std;
 
 RandomNumGen  rnGen(0);  // use random seed = 0
 MyUsage       myUsage;
+MyTrace       myTrace;
 
 
 //----------------------------------------------------------------------
@@ -11,12 +11,14 @@
 #include <istream>
 #include "rnGen.h"
 #include "myUsage.h"
+#include "myTrace.h"
 
 using namespace std;
 
 // Extern global variable defined in util.cpp
 extern RandomNumGen  rnGen;
 extern MyUsage       myUsage;
+extern MyTrace       myTrace;
 
 // In myString.cpp
 extern int myStrNCmp(const string& s1, const string& s2, unsigned n);
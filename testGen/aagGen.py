@@ -9,11 +9,15 @@
 import sys
 import random as rand
 
-if len(sys.argv) != 7:
-   print("Usage: python3 aagGen.py <fileName> <#MaxIdx> <#PI> <#LATCH> <#PO> <#AIG>")
+if len(sys.argv) not in (7, 8):
+   print("Usage: python3 aagGen.py <fileName> <#MaxIdx> <#PI> <#LATCH> <#PO> <#AIG> [seed]")
    print("Example: python3 aagGen.py 1.aag 1000 100 0 100 200")
    exit()
 
+# Same seed => same netlist
+if len(sys.argv) == 8:
+   rand.seed(int(sys.argv[7]))
+
 maxIdx = int(sys.argv[2])
 nPI    = int(sys.argv[3])
 nLATCH = int(sys.argv[4])
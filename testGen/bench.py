@@ -0,0 +1,179 @@
+#############################################################################
+#  FileName     [ bench.py ]
+#  PackageName  []
+#  Synopsis     [ Benchmark driver of read/opt/strash/sim/fraig ]
+#  Author       [ agent ]
+#  Date         [ 2026/10/18 created ]
+#############################################################################
+
+import os
+import re
+import sys
+import glob
+import time
+import json
+import argparse
+import tempfile
+import subprocess
+import statistics
+
+# Commands of one run; each phase is the command at the same index
+PHASES   = [ 'read', 'opt', 'strash', 'sim', 'fraig' ]
+COMMANDS = [ 'cirr {}', 'ciropt', 'cirstr', 'cirsim -r -seed 1 -stat', 'cirfraig -stat' ]
+
+# Metrics compared with the baseline: (name, tolerance is applied?)
+METRICS  = [ ('total', True), ('peak_mb', True), ('sat_calls', False), ('ands', False) ]
+METRICS += [ (p, True) for p in PHASES ]
+
+def parseArgs():
+   here = os.path.dirname(os.path.abspath(__file__))
+   root = os.path.dirname(here)
+   ap = argparse.ArgumentParser(description='Benchmark fraig on ISCAS85 and synthetic netlists.')
+   ap.add_argument('--fraig', default=os.path.join(root, 'fraig'), help='fraig executable')
+   ap.add_argument('--iscas', default=os.path.join(root, 'tests.fraig', 'ISCAS85'),
+                   help='directory of ISCAS85 *.aag ("" to skip)')
+   ap.add_argument('--sizes', default='1e4,1e5',
+                   help='#AND of synthetic netlists, comma separated ("" to skip), e.g. 1e4,1e5,1e6,1e7')
+   ap.add_argument('--aiggen', default=os.path.join(root, 'bin', 'aigGen'),
+                   help='generator of synthetic netlists')
+   ap.add_argument('--pi', type=int, default=64, help='#PI of synthetic netlists')
+   ap.add_argument('--fec', type=int, default=100, help='#planted FEC groups of synthetic netlists')
+   ap.add_argument('--seed', type=int, default=1, help='seed of synthetic netlists')
+   ap.add_argument('--repeat', type=int, default=3, help='runs per circuit; medians are reported')
+   ap.add_argument('--timeout', type=float, default=3600, help='seconds per run')
+   ap.add_argument('--workdir', default=os.path.join(tempfile.gettempdir(), 'fraig-bench'),
+                   help='where synthetic netlists are generated (kept for reuse)')
+   ap.add_argument('--baseline', help='baseline JSON to compare with')
+   ap.add_argument('--save', help='write the medians to this JSON (e.g. a new baseline)')
+   ap.add_argument('--tolerance', type=float, default=0.10,
+                   help='allowed slowdown/memory growth over the baseline (0.10 = 10%%)')
+   return ap.parse_args()
+
+def syntheticCircuit(args, nAnd):
+   os.makedirs(args.workdir, exist_ok=True)
+   fileName = os.path.join(args.workdir, 'syn_{}_{}_{}_{}.aag'.format(nAnd, args.pi, args.fec, args.seed))
+   if not os.path.exists(fileName):
+      nPO = max(1, min(nAnd // 100, 1000))
+      subprocess.run([ args.aiggen, 'rand', str(args.pi), str(nAnd), '-po', str(nPO),
+                       '-fec', str(args.fec), '-seed', str(args.seed), '-o', fileName ],
+                     check=True, stderr=subprocess.DEVNULL)
+   return fileName
+
+# Returns the metrics of one run, or a message if fraig did not finish
+def runOnce(args, aagFile):
+   with tempfile.TemporaryDirectory() as tmp:
+      dofile = os.path.join(tmp, 'do.bench')
+      prof = os.path.join(tmp, 'prof.json')
+      with open(dofile, 'w') as f:
+         f.write('cirv -q\n')
+         for c in COMMANDS:
+            f.write(c.format(aagFile) + '\n')
+         f.write('cirp -s\nq -f\n')
+
+      # Reap the child by wait4(), which gives the peak RSS of this run only
+      log = os.path.join(tmp, 'log')
+      with open(log, 'w') as fout:
+         p = subprocess.Popen([ args.fraig, '-f', dofile, '-p', prof ],
+                              stdout=fout, stderr=subprocess.STDOUT)
+      start = time.time()
+      while True:
+         pid, status, ru = os.wait4(p.pid, os.WNOHANG)
+         if pid: break
+         if time.time() - start > args.timeout:
+            p.kill()
+            os.wait4(p.pid, 0)
+            return 'timeout ({} s)'.format(args.timeout)
+         time.sleep(0.01)
+      # The profile is incomplete (or missing) unless fraig exited normally
+      if os.WIFSIGNALED(status):
+         return 'killed by signal {}'.format(os.WTERMSIG(status))
+      if os.WEXITSTATUS(status) != 0:
+         return 'exit code {}'.format(os.WEXITSTATUS(status))
+      out = open(log, errors='replace').read()
+      records = json.load(open(prof))
+
+   res = { 'total': 0.0 }
+   for phase, cmd in zip(PHASES, COMMANDS):
+      wall = [ r['wall'] for r in records if r['cmd'] == cmd.format(aagFile) ]
+      res[phase] = wall[0] if wall else 0.0
+      res['total'] += res[phase]
+   res['peak_mb'] = ru.ru_maxrss / 1024.0
+   m = re.search(r'^SAT calls: (\d+)', out, re.M)
+   res['sat_calls'] = int(m.group(1)) if m else 0
+   m = re.findall(r'^\s*AIG\s+(\d+)', out, re.M)
+   res['ands'] = int(m[-1]) if m else 0
+   return res
+
+def median(runs, key):
+   return statistics.median([ r[key] for r in runs ])
+
+def benchmark(args, name, aagFile):
+   runs = []
+   for i in range(args.repeat):
+      r = runOnce(args, aagFile)
+      if isinstance(r, str):
+         print('{:<16} {}'.format(name, r))
+         return None
+      runs.append(r)
+   res = { k: median(runs, k) for k in runs[0] }
+   print('{:<16} {:>9.3f} {:>9.1f} {:>9d} {:>9d}   '.format(
+         name, res['total'], res['peak_mb'], int(res['sat_calls']), int(res['ands']))
+         + ' '.join('{}={:.3f}'.format(p, res[p]) for p in PHASES))
+   return res
+
+def compare(args, results):
+   base = json.load(open(args.baseline))
+   nFail = 0
+   print('\nCompare with baseline {} (tolerance {:.0%})'.format(args.baseline, args.tolerance))
+   for name in sorted(base):
+      # A circuit of the baseline that timed out or failed is a regression
+      if name not in results:
+         nFail += 1
+         print('   REGRESSION {:<16} no result'.format(name))
+         continue
+      for key, bTol in METRICS:
+         old, new = base[name].get(key), results[name].get(key)
+         if old is None or new is None: continue
+         # Skip tiny timings, they are mostly noise
+         if bTol and key != 'peak_mb' and old < 0.05 and new < 0.05: continue
+         limit = old * (1 + args.tolerance) if bTol else old
+         if new > limit:
+            nFail += 1
+            print('   REGRESSION {:<16} {:<9} {:.3f} -> {:.3f}'.format(name, key, old, new))
+   print('{} regression(s)'.format(nFail))
+   return nFail
+
+def main():
+   args = parseArgs()
+   if not os.path.isfile(args.fraig):
+      print('Error: cannot find fraig executable "{}"'.format(args.fraig))
+      return 2
+   if args.sizes and not os.path.isfile(args.aiggen):
+      print('Error: cannot find aigGen executable "{}"'.format(args.aiggen))
+      return 2
+
+   circuits = []
+   if args.iscas:
+      for f in sorted(glob.glob(os.path.join(args.iscas, '*.aag'))):
+         circuits.append((os.path.splitext(os.path.basename(f))[0], f))
+   for s in filter(None, args.sizes.split(',')):
+      nAnd = int(float(s))
+      circuits.append(('syn_{}'.format(s), syntheticCircuit(args, nAnd)))
+
+   print('{:<16} {:>9} {:>9} {:>9} {:>9}'.format('circuit', 'time(s)', 'peak(MB)', '#SAT', '#AND'))
+   results = {}
+   for name, f in circuits:
+      res = benchmark(args, name, f)
+      if res is not None:
+         results[name] = res
+
+   if args.save:
+      with open(args.save, 'w') as f:
+         json.dump(results, f, indent=2, sort_keys=True)
+      print('Medians saved. ({})'.format(args.save))
+   if args.baseline:
+      return 1 if compare(args, results) else 0
+   return 0
+
+if __name__ == '__main__':
+   sys.exit(main())
@@ -0,0 +1,100 @@
+/****************************************************************************
+  FileName     [ apiTest.cpp ]
+  PackageName  [ regress ]
+  Synopsis     [ Drive the cirApi functions for sh.api ]
+  Author       [ agent ]
+  Date         [ 2026/10/18 created ]
+****************************************************************************/
+
+#include <iostream>
+#include <thread>
+#include <vector>
+#include "cirApi.h"
+
+using namespace std;
+
+static void
+printSize(const char* what, const CirSize& s)
+{
+   cout << what << ": PI " << s.nPi << ", PO " << s.nPo << ", AIG " << s.nAig << endl;
+}
+
+// read -> strash -> sim -> fraig -> write -> save -> load, one circuit
+static bool
+flow(const string& aag, const string& outPrefix)
+{
+   CirMgr mgr;
+   mgr.setVerbosity(CIR_VERB_QUIET);
+   CirReadResult r = cirRead(mgr, aag);
+   if (!r.bOk) {
+      cout << "read failed: " << r.errMsg;
+      return false;
+   }
+   printSize("read", r.size);
+
+   CirStrashResult st = cirStrash(mgr);
+   printSize("strash", st.after);
+
+   CirSimResult sim = cirRandomSim(mgr, 1);
+   cout << "sim: " << sim.nPatterns << " patterns, " << sim.nFecGrps
+        << " FEC group(s), " << sim.nCands << " candidate(s)" << endl;
+
+   CirFraigResult f = cirFraig(mgr);
+   printSize("fraig", f.after);
+   cout << "fraig: " << f.nMerged << " merged, SAT " << f.nSatCalls[CirStat::SAT_SAT]
+        << ", UNSAT " << f.nSatCalls[CirStat::SAT_UNSAT]
+        << (f.bTimeout ? ", timeout" : "") << endl;
+
+   if (!cirWrite(mgr, outPrefix + ".aag").bOk) return false;
+   CirWriteResult w = cirSave(mgr, outPrefix + ".snap");
+   if (!w.bOk) {
+      cout << "save failed: " << w.errMsg;
+      return false;
+   }
+   CirMgr mgr2;
+   CirReadResult l = cirLoad(mgr2, outPrefix + ".snap");
+   if (!l.bOk) {
+      cout << "load failed: " << l.errMsg;
+      return false;
+   }
+   printSize("load", l.size);
+   return true;
+}
+
+int
+main(int argc, char** argv)
+{
+   if (argc < 3) {
+      cerr << "Usage: apiTest <workDir> <aag>..." << endl;
+      return 2;
+   }
+   const string workDir = argv[1];
+
+   // One thread: print the results
+   if (!flow(argv[2], workDir + "/t0")) return 1;
+
+   // Errors are returned, not printed
+   CirMgr bad;
+   bad.setVerbosity(CIR_VERB_QUIET);
+   CirReadResult r = cirRead(bad, workDir + "/nosuch.aag");
+   cout << "missing file: bOk " << r.bOk << ", " << r.errMsg;
+
+   // One CirMgr per thread
+   vector<thread> vThreads;
+   vector<int> vOk(argc - 2, 0);
+   for (int i = 2; i < argc; ++i)
+      vThreads.emplace_back([&, i] {
+         CirMgr mgr;
+         mgr.setVerbosity(CIR_VERB_QUIET);
+         CirReadResult rr = cirRead(mgr, argv[i]);
+         if (!rr.bOk) return;
+         cirStrash(mgr);
+         cirRandomSim(mgr, 1);
+         cirFraig(mgr);
+         vOk[i - 2] = cirWrite(mgr, workDir + "/p" + to_string(i) + ".aag").bOk;
+      });
+   for (thread& th : vThreads) th.join();
+   for (int i = 2; i < argc; ++i)
+      cout << "thread " << argv[i] << ": " << (vOk[i - 2] ? "ok" : "failed") << endl;
+   return 0;
+}
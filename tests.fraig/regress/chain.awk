@@ -0,0 +1,10 @@
+# An AND chain of n PIs, gate n+k = x1 & ... & x(k+1), with the last gate
+# as the PO; the cones of the later gates are large (usage: -v n=4500)
+BEGIN {
+   M = 2 * n - 1
+   print "aag", M, n, 0, 1, n - 1
+   for (i = 1; i <= n; ++i) print 2 * i
+   print 2 * M
+   print 2 * (n + 1), 2, 4
+   for (k = 2; k < n; ++k) print 2 * (n + k), 2 * (n + k - 1), 2 * (k + 1)
+}
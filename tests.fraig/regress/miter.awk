@@ -0,0 +1,19 @@
+# Two copies of "aigGen mult", the second with the operands swapped
+NR == 1 { M = $2; I = $3; O = $5; A = $6; n = I / 2; next }
+NR <= 1 + I { next }
+NR <= 1 + I + O { po[NR - 1 - I] = $1; next }
+NR <= 1 + I + O + A { and[NR - 1 - I - O] = $0; next }
+function sw(l,   v) {
+   v = int(l / 2)
+   if (v == 0) return l
+   if (v <= I) return 2 * (v <= n ? v + n : v - n) + l % 2
+   return l + 2 * A
+}
+END {
+   print "aag", M + A, I, 0, 2 * O, 2 * A
+   for (i = 1; i <= I; ++i) print 2 * i
+   for (i = 1; i <= O; ++i) print po[i]
+   for (i = 1; i <= O; ++i) print sw(po[i])
+   for (i = 1; i <= A; ++i) print and[i]
+   for (i = 1; i <= A; ++i) { split(and[i], f, " "); print sw(f[1]), sw(f[2]), sw(f[3]) }
+}
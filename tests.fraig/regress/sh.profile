@@ -0,0 +1,14 @@
+# -Profile as CSV and as JSON: one row per command (the numbers vary)
+cat > work/do.cmds <<'END'
+cirr ../ISCAS85/C432.aag
+cirstrash
+cirsim -r -seed 1 -p 64
+cirfraig
+q -f
+END
+"$FRAIG" -f work/do.cmds -Profile work/prof.csv > /dev/null 2>&1
+"$FRAIG" -f work/do.cmds -Profile work/prof.json > /dev/null 2>&1
+echo "== prof.csv"
+awk -F, 'NR == 1 { print; next } { print $1, NF }' work/prof.csv
+echo "== prof.json"
+sed -e 's/": [0-9][0-9.]*/": #/g' work/prof.json
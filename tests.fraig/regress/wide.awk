@@ -0,0 +1,15 @@
+# Two levels of n*2 AIGs, half of them structural duplicates, so that
+# "CIRSTRash -Threads" hashes both levels in parallel (usage: -v n=20000)
+function pi(i) { return 2 * (1 + (i - 1) % n) }
+BEGIN {
+   A = 4 * n
+   print "aag", n + A, n, 0, 2 * n, A
+   for (i = 1; i <= n; ++i) print pi(i)
+   # g(i) = 2*(n+i), d(i) = 2*(2n+i), h(i) = 2*(3n+i), h'(i) = 2*(4n+i)
+   for (i = 1; i <= n; ++i) print 2 * (3 * n + i)
+   for (i = 1; i <= n; ++i) print 2 * (4 * n + i)
+   for (i = 1; i <= n; ++i) print 2 * (n + i), pi(i), pi(i + 1)
+   for (i = 1; i <= n; ++i) print 2 * (2 * n + i), pi(i + 1), pi(i)
+   for (i = 1; i <= n; ++i) print 2 * (3 * n + i), 2 * (n + i), 2 * (n + 1 + i % n) + 1
+   for (i = 1; i <= n; ++i) print 2 * (4 * n + i), 2 * (2 * n + 1 + i % n) + 1, 2 * (2 * n + i)
+}